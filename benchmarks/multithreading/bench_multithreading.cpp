@@ -23,11 +23,14 @@
 
 #include <chrono>
 #include <vector>
+#include <thread>
 
 #include <cgogn/core/utils/logger.h>
 #include <cgogn/core/cmap/cmap2.h>
 #include <cgogn/io/map_import.h>
 #include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/transform.h>
 
 #include <benchmark/benchmark.h>
 
@@ -54,6 +57,8 @@ template <typename T>
 using VertexAttribute = Map2::VertexAttribute<T>;
 template <typename T>
 using FaceAttribute = Map2::FaceAttribute<T>;
+template <typename T>
+using VertexAttributeSoA = cgogn::AttributeSoA<T, VERTEX>;
 
 static void BENCH_enqueue(benchmark::State& state)
 {
@@ -314,6 +319,85 @@ static void BENCH_vertices_normals_cache_multi_threaded(benchmark::State& state)
 	}
 }
 
+template <cgogn::TraversalStrategy STRATEGY>
+static void BENCH_vertices_normals_scaling(benchmark::State& state)
+{
+	cgogn::ThreadPool* tp = cgogn::thread_pool();
+	const uint32 nb_workers = tp->nb_workers();
+	tp->set_nb_workers(uint32(state.range(0)));
+
+	VertexAttribute<Vec3> vertex_position = bench_map.get_attribute<Vec3, VERTEX>("position");
+	cgogn_assert(vertex_position.is_valid());
+	VertexAttribute<Vec3> vertices_normal_mt = bench_map.get_attribute<Vec3, VERTEX>("normal_mt");
+	cgogn_assert(vertices_normal_mt.is_valid());
+
+	while(state.KeepRunning())
+	{
+		bench_map.template parallel_foreach_cell<STRATEGY>([&] (Vertex v)
+		{
+			vertices_normal_mt[v] = cgogn::geometry::normal<Vec3>(bench_map, v, vertex_position);
+		});
+	}
+
+	tp->set_nb_workers(nb_workers);
+}
+
+static Eigen::Matrix<float64, 4, 4> bench_transformation()
+{
+	Eigen::Matrix<float64, 4, 4> m;
+	m << 0.0, -1.0, 0.0, 0.5,
+		 1.0, 0.0, 0.0, 0.25,
+		 0.0, 0.0, 1.0, 0.0,
+		 0.0, 0.0, 0.0, 1.0;
+	return m;
+}
+
+static void BENCH_transform_position_aos(benchmark::State& state)
+{
+	VertexAttribute<Vec3> vertex_position = bench_map.get_attribute<Vec3, VERTEX>("position");
+	cgogn_assert(vertex_position.is_valid());
+	VertexAttribute<Vec3> vertex_position2 = bench_map.get_attribute<Vec3, VERTEX>("position2");
+	cgogn_assert(vertex_position2.is_valid());
+	const Eigen::Matrix<float64, 4, 4> m = bench_transformation();
+
+	while(state.KeepRunning())
+		cgogn::geometry::transform_position<Vec3>(bench_map, vertex_position, vertex_position2, m);
+}
+
+static void BENCH_transform_position_soa(benchmark::State& state)
+{
+	VertexAttributeSoA<Vec3> vertex_position = bench_map.get_soa_attribute<Vec3, VERTEX>("soa_position");
+	cgogn_assert(vertex_position.is_valid());
+	VertexAttributeSoA<Vec3> vertex_position2 = bench_map.get_soa_attribute<Vec3, VERTEX>("soa_position2");
+	cgogn_assert(vertex_position2.is_valid());
+	const Eigen::Matrix<float64, 4, 4> m = bench_transformation();
+
+	while(state.KeepRunning())
+		cgogn::geometry::transform_position<Vec3>(bench_map, vertex_position, vertex_position2, m);
+}
+
+static void BENCH_filter_average_aos(benchmark::State& state)
+{
+	VertexAttribute<Vec3> vertex_position = bench_map.get_attribute<Vec3, VERTEX>("position");
+	cgogn_assert(vertex_position.is_valid());
+	VertexAttribute<Vec3> vertex_position2 = bench_map.get_attribute<Vec3, VERTEX>("position2");
+	cgogn_assert(vertex_position2.is_valid());
+
+	while(state.KeepRunning())
+		cgogn::geometry::filter_average<Vec3>(bench_map, vertex_position, vertex_position2);
+}
+
+static void BENCH_filter_average_soa(benchmark::State& state)
+{
+	VertexAttributeSoA<Vec3> vertex_position = bench_map.get_soa_attribute<Vec3, VERTEX>("soa_position");
+	cgogn_assert(vertex_position.is_valid());
+	VertexAttributeSoA<Vec3> vertex_position2 = bench_map.get_soa_attribute<Vec3, VERTEX>("soa_position2");
+	cgogn_assert(vertex_position2.is_valid());
+
+	while(state.KeepRunning())
+		cgogn::geometry::filter_average<Vec3>(bench_map, vertex_position, vertex_position2);
+}
+
 BENCHMARK(BENCH_enqueue)->UseRealTime();
 
 BENCHMARK(BENCH_Dart_count_single_threaded);
@@ -323,6 +407,7 @@ BENCHMARK_TEMPLATE(BENCH_faces_normals_single_threaded, cgogn::TraversalStrategy
 BENCHMARK_TEMPLATE(BENCH_faces_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_DART_MARKING)->UseRealTime();
 BENCHMARK_TEMPLATE(BENCH_faces_normals_single_threaded, cgogn::TraversalStrategy::FORCE_CELL_MARKING)->UseRealTime();
 BENCHMARK_TEMPLATE(BENCH_faces_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_CELL_MARKING)->UseRealTime();
+BENCHMARK_TEMPLATE(BENCH_faces_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_CHUNK_SCAN)->UseRealTime();
 BENCHMARK(BENCH_faces_normals_cache_single_threaded)->UseRealTime();
 BENCHMARK(BENCH_faces_normals_cache_multi_threaded)->UseRealTime();
 
@@ -330,9 +415,21 @@ BENCHMARK_TEMPLATE(BENCH_vertices_normals_single_threaded, cgogn::TraversalStrat
 BENCHMARK_TEMPLATE(BENCH_vertices_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_DART_MARKING)->UseRealTime();
 BENCHMARK_TEMPLATE(BENCH_vertices_normals_single_threaded, cgogn::TraversalStrategy::FORCE_CELL_MARKING)->UseRealTime();
 BENCHMARK_TEMPLATE(BENCH_vertices_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_CELL_MARKING)->UseRealTime();
+BENCHMARK_TEMPLATE(BENCH_vertices_normals_multi_threaded, cgogn::TraversalStrategy::FORCE_CHUNK_SCAN)->UseRealTime();
 BENCHMARK(BENCH_vertices_normals_cache_single_threaded)->UseRealTime();
 BENCHMARK(BENCH_vertices_normals_cache_multi_threaded)->UseRealTime();
 
+// array of structures vs structure of arrays layout
+BENCHMARK(BENCH_transform_position_aos)->UseRealTime();
+BENCHMARK(BENCH_transform_position_soa)->UseRealTime();
+BENCHMARK(BENCH_filter_average_aos)->UseRealTime();
+BENCHMARK(BENCH_filter_average_soa)->UseRealTime();
+
+// scaling with the number of workers
+BENCHMARK_TEMPLATE(BENCH_vertices_normals_scaling, cgogn::TraversalStrategy::FORCE_DART_MARKING)->DenseRange(1, int(std::thread::hardware_concurrency()))->UseRealTime();
+BENCHMARK_TEMPLATE(BENCH_vertices_normals_scaling, cgogn::TraversalStrategy::FORCE_CELL_MARKING)->DenseRange(1, int(std::thread::hardware_concurrency()))->UseRealTime();
+BENCHMARK_TEMPLATE(BENCH_vertices_normals_scaling, cgogn::TraversalStrategy::FORCE_CHUNK_SCAN)->DenseRange(1, int(std::thread::hardware_concurrency()))->UseRealTime();
+
 
 int main(int argc, char** argv)
 {
@@ -354,6 +451,12 @@ int main(int argc, char** argv)
 	bench_map.add_attribute<Vec3, FACE>("normal_mt");
 	bench_map.add_attribute<Vec3, VERTEX>("normal");
 	bench_map.add_attribute<Vec3, VERTEX>("normal_mt");
+	bench_map.add_attribute<Vec3, VERTEX>("position2");
+
+	VertexAttribute<Vec3> vertex_position = bench_map.get_attribute<Vec3, VERTEX>("position");
+	VertexAttributeSoA<Vec3> soa_position = bench_map.add_soa_attribute<Vec3, VERTEX>("soa_position");
+	bench_map.add_soa_attribute<Vec3, VERTEX>("soa_position2");
+	bench_map.foreach_cell([&] (Vertex v) { soa_position[v] = vertex_position[v]; });
 
 	::benchmark::RunSpecifiedBenchmarks();
 	return 0;
@@ -30,6 +30,7 @@
 #include <cgogn/io/map_import.h>
 #include <cgogn/geometry/algos/normal.h>
 #include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/topology/types/corner_table_view.h>
 
 #include <benchmark/benchmark.h>
 
@@ -180,12 +181,134 @@ static void BENCH_vertices_filter_tri(benchmark::State& state)
 	}
 }
 
+static void BENCH_corner_table_build(benchmark::State& state)
+{
+	cgogn::topology::CornerTableView<TMap2> corner_table(bench_tri_map);
+	while(state.KeepRunning())
+	{
+		corner_table.build();
+	}
+}
+
+static void BENCH_faces_normals_corner_table(benchmark::State& state)
+{
+	cgogn::topology::CornerTableView<TMap2> corner_table(bench_tri_map);
+	corner_table.build();
+	std::vector<Vec3> face_normal(corner_table.nb_faces());
+	while(state.KeepRunning())
+	{
+		state.PauseTiming();
+		TVertexAttribute<Vec3> vertex_position = bench_tri_map.get_attribute<Vec3, TVERTEX>("position");
+		cgogn_assert(vertex_position.is_valid());
+		state.ResumeTiming();
+
+		corner_table.foreach_face([&] (uint32 f)
+		{
+			Vec3 n = cgogn::geometry::normal(
+				vertex_position[corner_table.vertex(3u * f)],
+				vertex_position[corner_table.vertex(3u * f + 1u)],
+				vertex_position[corner_table.vertex(3u * f + 2u)]
+			);
+			cgogn::geometry::normalize_safe(n);
+			face_normal[f] = n;
+		});
+	}
+}
+
+static void BENCH_vertices_normals_corner_table(benchmark::State& state)
+{
+	cgogn::topology::CornerTableView<TMap2> corner_table(bench_tri_map);
+	corner_table.build();
+	while(state.KeepRunning())
+	{
+		state.PauseTiming();
+		TVertexAttribute<Vec3> vertex_position = bench_tri_map.get_attribute<Vec3, TVERTEX>("position");
+		cgogn_assert(vertex_position.is_valid());
+		TVertexAttribute<Vec3> vertices_normal = bench_tri_map.get_attribute<Vec3, TVERTEX>("normal");
+		cgogn_assert(vertices_normal.is_valid());
+		state.ResumeTiming();
+
+		// area weighted sum of the normals of the incident triangles
+		corner_table.foreach_vertex([&] (uint32 v)
+		{
+			Vec3 n{0.0, 0.0, 0.0};
+			corner_table.foreach_corner_of_vertex(v, [&] (uint32 c)
+			{
+				n += cgogn::geometry::normal(
+					vertex_position[v],
+					vertex_position[corner_table.vertex(corner_table.next(c))],
+					vertex_position[corner_table.vertex(corner_table.prev(c))]
+				);
+			});
+			cgogn::geometry::normalize_safe(n);
+			vertices_normal[v] = n;
+		});
+	}
+}
+
+static void BENCH_vertices_laplacian_corner_table(benchmark::State& state)
+{
+	cgogn::topology::CornerTableView<TMap2> corner_table(bench_tri_map);
+	corner_table.build();
+	while(state.KeepRunning())
+	{
+		state.PauseTiming();
+		TVertexAttribute<Vec3> vertex_position = bench_tri_map.get_attribute<Vec3, TVERTEX>("position");
+		cgogn_assert(vertex_position.is_valid());
+		TVertexAttribute<Vec3> vertex_position2 = bench_tri_map.get_attribute<Vec3, TVERTEX>("position2");
+		cgogn_assert(vertex_position2.is_valid());
+		state.ResumeTiming();
+
+		corner_table.parallel_foreach_vertex([&] (uint32 v)
+		{
+			Vec3 sum{0.0, 0.0, 0.0};
+			uint32 count = 0u;
+			corner_table.foreach_adjacent_vertex_through_edge(v, [&] (uint32 av)
+			{
+				sum += vertex_position[av];
+				++count;
+			});
+			vertex_position2[v] = sum / float64(count);
+		});
+	}
+}
+
+static void BENCH_vertices_laplacian_tri(benchmark::State& state)
+{
+	while(state.KeepRunning())
+	{
+		state.PauseTiming();
+		TVertexAttribute<Vec3> vertex_position = bench_tri_map.get_attribute<Vec3, TVERTEX>("position");
+		cgogn_assert(vertex_position.is_valid());
+		TVertexAttribute<Vec3> vertex_position2 = bench_tri_map.get_attribute<Vec3, TVERTEX>("position2");
+		cgogn_assert(vertex_position2.is_valid());
+		state.ResumeTiming();
+
+		bench_tri_map.parallel_foreach_cell([&] (TVertex v)
+		{
+			Vec3 sum{0.0, 0.0, 0.0};
+			uint32 count = 0u;
+			bench_tri_map.foreach_adjacent_vertex_through_edge(v, [&] (TVertex av)
+			{
+				sum += vertex_position[av];
+				++count;
+			});
+			vertex_position2[v] = sum / float64(count);
+		});
+	}
+}
+
 BENCHMARK(BENCH_faces_normals_poly);
 BENCHMARK(BENCH_faces_normals_tri);
 BENCHMARK(BENCH_vertices_normals_poly);
 BENCHMARK(BENCH_vertices_normals_tri);
 BENCHMARK(BENCH_vertices_filter_poly)->UseRealTime();
 BENCHMARK(BENCH_vertices_filter_tri)->UseRealTime();
+BENCHMARK(BENCH_corner_table_build)->UseRealTime();
+BENCHMARK(BENCH_faces_normals_corner_table);
+BENCHMARK(BENCH_vertices_normals_corner_table);
+BENCHMARK(BENCH_vertices_laplacian_tri)->UseRealTime();
+BENCHMARK(BENCH_vertices_laplacian_corner_table)->UseRealTime();
 
 int main(int argc, char** argv)
 {
@@ -218,6 +218,86 @@ public:
 	{}
 };
 
+/**
+ * @brief cell marker based on epoch stamps
+ * A cell is marked when its stamp is equal to the current epoch of the stamp attribute.
+ * unmark_all (called at destruction) only starts a new epoch, its cost does not depend on
+ * the number of cells of the map nor on the number of marked cells.
+ */
+template <typename MAP, Orbit ORBIT>
+class CellMarkerEpoch
+{
+	static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+
+public:
+
+	using Self = CellMarkerEpoch<MAP, ORBIT>;
+	using Map = MAP;
+	using ChunkArrayGen = typename Map::ChunkArrayGen;
+	using ChunkArrayStamp = typename Map::ChunkArrayStamp;
+
+protected:
+
+	MAP& map_;
+	ChunkArrayStamp* stamp_attribute_;
+
+public:
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellMarkerEpoch);
+
+	CellMarkerEpoch(const MAP& map) :
+		map_(const_cast<MAP&>(map))
+	{
+		stamp_attribute_ = map_.template stamp_attribute<ORBIT>();
+		stamp_attribute_->add_external_ref(reinterpret_cast<ChunkArrayGen**>(&stamp_attribute_));
+	}
+
+	~CellMarkerEpoch()
+	{
+		if (is_valid())
+		{
+			unmark_all();
+			stamp_attribute_->remove_external_ref(reinterpret_cast<ChunkArrayGen**>(&stamp_attribute_));
+			map_.template release_stamp_attribute<ORBIT>(stamp_attribute_);
+		}
+	}
+
+	inline void mark(Cell<ORBIT> c)
+	{
+		cgogn_message_assert(is_valid(), "Invalid CellMarkerEpoch");
+		stamp_attribute_->mark(map_.embedding(c));
+	}
+
+	inline void unmark(Cell<ORBIT> c)
+	{
+		cgogn_message_assert(is_valid(), "Invalid CellMarkerEpoch");
+		stamp_attribute_->unmark(map_.embedding(c));
+	}
+
+	inline bool is_marked(Cell<ORBIT> c) const
+	{
+		cgogn_message_assert(is_valid(), "Invalid CellMarkerEpoch");
+		return stamp_attribute_->is_marked(map_.embedding(c));
+	}
+
+	inline void unmark_all()
+	{
+		cgogn_message_assert(is_valid(), "Invalid CellMarkerEpoch");
+		stamp_attribute_->unmark_all();
+	}
+
+	inline bool is_valid() const
+	{
+		// same reasoning as CellMarker_T::is_valid (stamp attributes are only deleted at map destruction)
+		return stamp_attribute_ != nullptr;
+	}
+
+	inline uint32 nb_marked()
+	{
+		return stamp_attribute_->count_marked();
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_BASIC_CELL_MARKER_H_
@@ -24,7 +24,10 @@
 #ifndef CGOGN_CORE_BASIC_DART_MARKER_H_
 #define CGOGN_CORE_BASIC_DART_MARKER_H_
 
+#include <array>
+
 #include <cgogn/core/utils/buffers.h>
+#include <cgogn/core/utils/unique_ptr.h>
 
 #include <cgogn/core/cmap/map_base_data.h>
 #include <cgogn/core/container/chunk_array.h>
@@ -245,6 +248,260 @@ public:
 	{}
 };
 
+/**
+ * @brief dart marker based on epoch stamps
+ * A dart is marked when its stamp is equal to the current epoch of the stamp attribute.
+ * unmark_all (called at destruction) only starts a new epoch, its cost does not depend on
+ * the number of darts of the map nor on the number of marked darts.
+ */
+template <typename MAP>
+class DartMarkerEpoch
+{
+public:
+
+	using Self = DartMarkerEpoch<MAP>;
+	using Map = MAP;
+	using ChunkArrayGen = typename Map::ChunkArrayGen;
+	using ChunkArrayStamp = typename Map::ChunkArrayStamp;
+
+protected:
+
+	Map& map_;
+	ChunkArrayStamp* stamp_attribute_;
+
+public:
+
+	DartMarkerEpoch(const MAP& map) :
+		map_(const_cast<MAP&>(map))
+	{
+		stamp_attribute_ = map_.topology_stamp_attribute();
+		stamp_attribute_->add_external_ref(reinterpret_cast<ChunkArrayGen**>(&stamp_attribute_));
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(DartMarkerEpoch);
+
+	~DartMarkerEpoch()
+	{
+		if (is_valid())
+		{
+			unmark_all();
+			stamp_attribute_->remove_external_ref(reinterpret_cast<ChunkArrayGen**>(&stamp_attribute_));
+			map_.release_topology_stamp_attribute(stamp_attribute_);
+		}
+	}
+
+	inline void mark(Dart d)
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		stamp_attribute_->mark(d.index);
+	}
+
+	inline void unmark(Dart d)
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		stamp_attribute_->unmark(d.index);
+	}
+
+	inline bool is_marked(Dart d) const
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		return stamp_attribute_->is_marked(d.index);
+	}
+
+	template <Orbit ORBIT>
+	inline void mark_orbit(Cell<ORBIT> c)
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		map_.foreach_dart_of_orbit(c, [&] (Dart d)
+		{
+			stamp_attribute_->mark(d.index);
+		});
+	}
+
+	template <Orbit ORBIT>
+	inline void unmark_orbit(Cell<ORBIT> c)
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		map_.foreach_dart_of_orbit(c, [&] (Dart d)
+		{
+			stamp_attribute_->unmark(d.index);
+		});
+	}
+
+	inline void unmark_all()
+	{
+		cgogn_message_assert(is_valid(), "Invalid DartMarkerEpoch");
+		stamp_attribute_->unmark_all();
+	}
+
+	inline bool is_valid() const
+	{
+		// same reasoning as DartMarker_T::is_valid (stamp attributes are only deleted at map destruction)
+		return stamp_attribute_ != nullptr;
+	}
+};
+
+/**
+ * @brief dart marker for local traversals (incidence queries, orbits of small cells)
+ * The marked darts are stored in a small hash set allocated with the marker (on the stack),
+ * no mark attribute is taken from the map and nothing is allocated.
+ * When more than NB_LOCAL darts are marked, the marker falls back on a DartMarkerEpoch
+ * until the next unmark_all.
+ * @tparam NB_LOCAL maximum number of darts marked without the fallback (power of 2)
+ */
+template <typename MAP, uint32 NB_LOCAL = 128u>
+class DartMarkerLocal
+{
+	static_assert(NB_LOCAL >= 2u && (NB_LOCAL & (NB_LOCAL - 1u)) == 0u, "NB_LOCAL must be a power of 2");
+
+public:
+
+	using Self = DartMarkerLocal<MAP, NB_LOCAL>;
+	using Map = MAP;
+	using Fallback = DartMarkerEpoch<MAP>;
+
+protected:
+
+	static const uint32 NB_SLOTS = 2u * NB_LOCAL; // load factor <= 1/2
+	static const uint32 SLOT_MASK = NB_SLOTS - 1u;
+
+	const Map& map_;
+	std::array<uint32, NB_SLOTS> slots_;
+	uint32 nb_marked_;
+	std::unique_ptr<Fallback> fallback_;
+	bool use_fallback_;
+
+	inline static uint32 home_slot(uint32 index)
+	{
+		const uint32 h = index * 2654435761u;
+		return (h ^ (h >> 16u)) & SLOT_MASK;
+	}
+
+	inline uint32 find_slot(uint32 index) const
+	{
+		uint32 s = home_slot(index);
+		while (slots_[s] != index && slots_[s] != INVALID_INDEX)
+			s = (s + 1u) & SLOT_MASK;
+		return s;
+	}
+
+	inline void switch_to_fallback()
+	{
+		if (!fallback_)
+			fallback_ = cgogn::make_unique<Fallback>(map_);
+		for (uint32& s : slots_)
+		{
+			if (s != INVALID_INDEX)
+			{
+				fallback_->mark(Dart(s));
+				s = INVALID_INDEX;
+			}
+		}
+		nb_marked_ = 0u;
+		use_fallback_ = true;
+	}
+
+public:
+
+	DartMarkerLocal(const MAP& map) :
+		map_(map),
+		nb_marked_(0u),
+		use_fallback_(false)
+	{
+		slots_.fill(INVALID_INDEX);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(DartMarkerLocal);
+
+	inline void mark(Dart d)
+	{
+		if (use_fallback_)
+			return fallback_->mark(d);
+		const uint32 s = find_slot(d.index);
+		if (slots_[s] == d.index)
+			return;
+		if (nb_marked_ == NB_LOCAL)
+		{
+			switch_to_fallback();
+			return fallback_->mark(d);
+		}
+		slots_[s] = d.index;
+		++nb_marked_;
+	}
+
+	inline void unmark(Dart d)
+	{
+		if (use_fallback_)
+			return fallback_->unmark(d);
+		uint32 i = find_slot(d.index);
+		if (slots_[i] == INVALID_INDEX)
+			return;
+		--nb_marked_;
+		// backward shift deletion (keeps the probe sequences without tombstones)
+		uint32 j = i;
+		while (true)
+		{
+			slots_[i] = INVALID_INDEX;
+			uint32 k;
+			do
+			{
+				j = (j + 1u) & SLOT_MASK;
+				if (slots_[j] == INVALID_INDEX)
+					return;
+				k = home_slot(slots_[j]);
+			} while (i <= j ? (i < k && k <= j) : (i < k || k <= j));
+			slots_[i] = slots_[j];
+			i = j;
+		}
+	}
+
+	inline bool is_marked(Dart d) const
+	{
+		if (use_fallback_)
+			return fallback_->is_marked(d);
+		return slots_[find_slot(d.index)] == d.index;
+	}
+
+	template <Orbit ORBIT>
+	inline void mark_orbit(Cell<ORBIT> c)
+	{
+		map_.foreach_dart_of_orbit(c, [this] (Dart d) { this->mark(d); });
+	}
+
+	template <Orbit ORBIT>
+	inline void unmark_orbit(Cell<ORBIT> c)
+	{
+		map_.foreach_dart_of_orbit(c, [this] (Dart d) { this->unmark(d); });
+	}
+
+	inline void unmark_all()
+	{
+		if (use_fallback_)
+		{
+			fallback_->unmark_all();
+			use_fallback_ = false;
+		}
+		if (nb_marked_ > 0u)
+		{
+			slots_.fill(INVALID_INDEX);
+			nb_marked_ = 0u;
+		}
+	}
+
+	/**
+	 * @return true if the marked darts did not fit in the local storage
+	 */
+	inline bool uses_fallback() const
+	{
+		return use_fallback_;
+	}
+
+	inline bool is_valid() const
+	{
+		return !use_fallback_ || fallback_->is_valid();
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_BASIC_DART_MARKER_H_
@@ -177,6 +177,23 @@ public:
 		return chunk_array_;
 	}
 
+	/**
+	 * \brief get the data of a chunk of the attribute (CHUNK_SIZE contiguous elements)
+	 * @param chunk index of the chunk
+	 * @see ChunkArrayContainer::foreach_chunk
+	 */
+	inline T* chunk_data(uint32 chunk)
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->chunk_data(chunk);
+	}
+
+	inline const T* chunk_data(uint32 chunk) const
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->chunk_data(chunk);
+	}
+
 	/**
 	 * \brief affect a value to all elements of container (even holes)
 	 * @param val value to affect
@@ -453,6 +470,165 @@ public:
 	}
 };
 
+/**
+ * \brief Attribute class for data stored with a structure of arrays layout (ChunkArraySoA)
+ * operator[] returns a SoAReference proxy that converts to and from T, so that the
+ * element-wise code written for Attribute compiles, while the chunk-wise kernels
+ * can access each component chunk directly through chunk_data(chunk, k).
+ * @TPARAM T the data type of the attribute to handle
+ */
+template <typename T, Orbit ORBIT>
+class AttributeSoA : public AttributeGen
+{
+public:
+
+	using Inherit = AttributeGen;
+	using Self = AttributeSoA<T, ORBIT>;
+	using value_type = T;
+
+	using ChunkArrayGen = typename Inherit::ChunkArrayGen;
+	using ChunkArrayContainer = typename Inherit::ChunkArrayContainer;
+	using TChunkArray = MapBaseData::ChunkArraySoA<T>;
+	using Scalar = typename TChunkArray::Scalar;
+	using reference = typename TChunkArray::reference;
+
+	static const Orbit orb_ = ORBIT;
+
+	inline AttributeSoA() :
+		Inherit(nullptr),
+		chunk_array_cont_(nullptr),
+		chunk_array_(nullptr)
+	{}
+
+	AttributeSoA(MapBaseData* const map, TChunkArray* const ca) :
+		Inherit(map),
+		chunk_array_cont_(nullptr),
+		chunk_array_(ca)
+	{
+		if (map != nullptr)
+			chunk_array_cont_ = &map->attribute_container(ORBIT);
+		if (chunk_array_ != nullptr)
+			chunk_array_->add_external_ref(reinterpret_cast<ChunkArrayGen**>(&chunk_array_));
+	}
+
+	AttributeSoA(const Self& att) :
+		Inherit(att),
+		chunk_array_cont_(att.chunk_array_cont_),
+		chunk_array_(att.chunk_array_)
+	{
+		if (chunk_array_ != nullptr)
+			chunk_array_->add_external_ref(reinterpret_cast<ChunkArrayGen**>(&chunk_array_));
+	}
+
+	inline AttributeSoA& operator=(const Self& att)
+	{
+		if (this != &att)
+		{
+			Inherit::operator=(att);
+
+			if (is_valid())
+				chunk_array_->remove_external_ref(reinterpret_cast<ChunkArrayGen**>(&chunk_array_));
+
+			chunk_array_cont_ = att.chunk_array_cont_;
+			chunk_array_ = att.chunk_array_;
+
+			if (chunk_array_ != nullptr)
+				chunk_array_->add_external_ref(reinterpret_cast<ChunkArrayGen**>(&chunk_array_));
+		}
+		return *this;
+	}
+
+	virtual ~AttributeSoA() override
+	{
+		if (is_valid())
+			chunk_array_->remove_external_ref(reinterpret_cast<ChunkArrayGen**>(&chunk_array_));
+	}
+
+	TChunkArray const* data() const
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_;
+	}
+
+	/**
+	 * \brief get the data of the component k of a chunk of the attribute (CHUNK_SIZE contiguous values)
+	 * @see ChunkArrayContainer::foreach_chunk
+	 */
+	inline Scalar* chunk_data(uint32 chunk, uint32 k)
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->chunk_data(chunk, k);
+	}
+
+	inline const Scalar* chunk_data(uint32 chunk, uint32 k) const
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->chunk_data(chunk, k);
+	}
+
+	inline void set_all_values(const T& val)
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		chunk_array_->set_all_values(val);
+	}
+
+	inline reference operator[](uint32 i)
+	{
+		cgogn_message_assert(is_valid(), "Invalid Attribute");
+		return chunk_array_->operator[](i);
+	}
+
+	inline T operator[](uint32 i) const
+	{
+		cgogn_message_assert(is_valid(), "Invalid Attribute");
+		return static_cast<const TChunkArray*>(chunk_array_)->operator[](i);
+	}
+
+	inline reference operator[](Cell<ORBIT> c)
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->operator[](this->map_->embedding(c));
+	}
+
+	inline T operator[](Cell<ORBIT> c) const
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return static_cast<const TChunkArray*>(chunk_array_)->operator[](this->map_->embedding(c));
+	}
+
+	virtual const std::string& name() const override
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->name();
+	}
+
+	virtual const std::string& type_name() const override
+	{
+		cgogn_message_assert(this->is_valid(), "Invalid Attribute");
+		return chunk_array_->type_name();
+	}
+
+	virtual bool is_valid() const override
+	{
+		return chunk_array_ != nullptr;
+	}
+
+	inline Orbit orbit() const
+	{
+		return ORBIT;
+	}
+
+	inline uint32 size() const
+	{
+		return this->chunk_array_cont_->size();
+	}
+
+protected:
+
+	const ChunkArrayContainer* chunk_array_cont_;
+	TChunkArray*               chunk_array_;
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_MAP_ATTRIBUTE_H_
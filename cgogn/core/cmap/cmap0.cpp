@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap0_T<CMap0Type>;
 template class CGOGN_CORE_API DartMarker<CMap0>;
 template class CGOGN_CORE_API DartMarkerStore<CMap0>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap0>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap0>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap0>;
 template class CGOGN_CORE_API CellMarker<CMap0, CMap0::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarkerNoUnmark<CMap0, CMap0::Vertex::ORBIT>;
@@ -62,6 +62,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -69,6 +71,8 @@ public:
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<Self, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerStore = typename cgogn::CellMarkerStore<Self, ORBIT>;
+	template <Orbit ORBIT>
+	using CellMarkerEpoch = typename cgogn::CellMarkerEpoch<Self, ORBIT>;
 
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
@@ -216,6 +220,8 @@ using CMap0 = CMap0_T<CMap0Type>;
 extern template class CGOGN_CORE_API CMap0_T<CMap0Type>;
 extern template class CGOGN_CORE_API DartMarker<CMap0>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap0>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap0>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap0>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap0>;
 extern template class CGOGN_CORE_API CellMarker<CMap0, CMap0::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap0, CMap0::Vertex::ORBIT>;
@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap1_T<CMap1Type>;
 template class CGOGN_CORE_API DartMarker<CMap1>;
 template class CGOGN_CORE_API DartMarkerStore<CMap1>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap1>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap1>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap1>;
 template class CGOGN_CORE_API CellMarker<CMap1, CMap1::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap1, CMap1::Face::ORBIT>;
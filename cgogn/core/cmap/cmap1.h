@@ -65,6 +65,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -72,6 +74,8 @@ public:
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<Self, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerStore = typename cgogn::CellMarkerStore<Self, ORBIT>;
+	template <Orbit ORBIT>
+	using CellMarkerEpoch = typename cgogn::CellMarkerEpoch<Self, ORBIT>;
 
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
@@ -572,6 +576,8 @@ using CMap1 = CMap1_T<CMap1Type>;
 extern template class CGOGN_CORE_API CMap1_T<CMap1Type>;
 extern template class CGOGN_CORE_API DartMarker<CMap1>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap1>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap1>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap1>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap1>;
 extern template class CGOGN_CORE_API CellMarker<CMap1, CMap1::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap1, CMap1::Face::ORBIT>;
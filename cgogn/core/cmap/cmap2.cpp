@@ -32,6 +32,8 @@ template class CGOGN_CORE_API CMap2_T<CMap2Type>;
 template class CGOGN_CORE_API CMap2Builder_T<CMap2>;
 template class CGOGN_CORE_API DartMarker<CMap2>;
 template class CGOGN_CORE_API DartMarkerStore<CMap2>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap2>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap2>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2>;
 template class CGOGN_CORE_API CellMarker<CMap2, CMap2::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap2, CMap2::Edge::ORBIT>;
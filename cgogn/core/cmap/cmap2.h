@@ -24,6 +24,10 @@
 #ifndef CGOGN_CORE_CMAP_CMAP2_H_
 #define CGOGN_CORE_CMAP_CMAP2_H_
 
+#include <array>
+
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/utils/independent_sets.h>
 #include <cgogn/core/cmap/cmap1.h>
 #include <cgogn/core/cmap/cmap2_builder.h>
 
@@ -77,6 +81,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 	using DartMarkerNoUnmark = typename cgogn::DartMarkerNoUnmark<Self>;
 
 	template <Orbit ORBIT>
@@ -85,6 +91,8 @@ public:
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<Self, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerStore = typename cgogn::CellMarkerStore<Self, ORBIT>;
+	template <Orbit ORBIT>
+	using CellMarkerEpoch = typename cgogn::CellMarkerEpoch<Self, ORBIT>;
 
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
@@ -832,6 +840,320 @@ public:
 		return v;
 	}
 
+public:
+
+	/**
+	 * @brief Cut a set of edges
+	 * @param edges : the edges to cut (they must be distinct)
+	 * @return the inserted vertices, in the order of the edges
+	 * The result is the same as cutting each edge with cut_edge, but the new darts and attribute lines
+	 * are allocated at once and the new darts are sewn and embedded in parallel (the cuts of distinct edges
+	 * never overlap).
+	 */
+	std::vector<Vertex> cut_edges(const std::vector<Edge>& edges)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const uint32 nb_edges = uint32(edges.size());
+		const bool emb_vertex = this->template is_embedded<Vertex>();
+		const bool emb_edge = this->template is_embedded<Edge>();
+		const bool emb_face = this->template is_embedded<Face>();
+		const bool emb_volume = this->template is_embedded<Volume>();
+
+		// allocation of the new darts (2 per edge) and of the lines of the new vertices and edges
+		std::vector<Dart> new_darts(2u * nb_edges);
+		this->topology_.reserve(2u * nb_edges * PRIM_SIZE);
+		for (uint32 i = 0u; i < nb_edges; ++i)
+		{
+			const Dart d = edges[i].dart;
+			new_darts[2u * i] = this->add_topology_element();
+			new_darts[2u * i + 1u] = this->add_topology_element();
+			this->set_boundary(new_darts[2u * i], this->is_boundary(d));
+			this->set_boundary(new_darts[2u * i + 1u], this->is_boundary(phi2(d)));
+		}
+
+		std::vector<uint32> vertex_lines;
+		std::vector<uint32> edge_lines;
+		if (emb_vertex)
+		{
+			this->attributes_[Vertex::ORBIT].reserve(nb_edges);
+			vertex_lines.resize(nb_edges);
+			for (uint32& l : vertex_lines)
+				l = this->template add_attribute_element<Vertex::ORBIT>();
+		}
+		if (emb_edge)
+		{
+			this->attributes_[Edge::ORBIT].reserve(nb_edges);
+			edge_lines.resize(nb_edges);
+			for (uint32& l : edge_lines)
+				l = this->template add_attribute_element<Edge::ORBIT>();
+		}
+
+		parallel_foreach_index(nb_edges, [&] (uint32 i)
+		{
+			const Dart d = edges[i].dart;
+			const Dart e = phi2(d);
+			const Dart nd = new_darts[2u * i];
+			const Dart ne = new_darts[2u * i + 1u];
+
+			phi2_unsew(d);
+			this->phi1_sew(d, nd);
+			this->phi1_sew(e, ne);
+			phi2_sew(d, ne);
+			phi2_sew(e, nd);
+
+			if (emb_vertex)
+			{
+				this->template set_embedding_unreferenced<Vertex>(nd, vertex_lines[i]);
+				this->template set_embedding_unreferenced<Vertex>(ne, vertex_lines[i]);
+			}
+			if (emb_edge)
+			{
+				this->template set_embedding_unreferenced<Edge>(ne, this->embedding(Edge(d)));
+				this->template set_embedding_unreferenced<Edge>(nd, edge_lines[i]);
+				this->template set_embedding_unreferenced<Edge>(e, edge_lines[i]);
+			}
+			if (emb_face)
+			{
+				if (!this->is_boundary(d))
+					this->template set_embedding_unreferenced<Face>(nd, this->embedding(Face(d)));
+				if (!this->is_boundary(e))
+					this->template set_embedding_unreferenced<Face>(ne, this->embedding(Face(e)));
+			}
+			if (emb_volume)
+			{
+				this->template set_embedding_unreferenced<Volume>(nd, this->embedding(Volume(d)));
+				this->template set_embedding_unreferenced<Volume>(ne, this->embedding(Volume(d)));
+			}
+		});
+
+		// reference counters: the edge of d keeps as many darts (e is replaced by ne)
+		std::vector<Vertex> result(nb_edges);
+		for (uint32 i = 0u; i < nb_edges; ++i)
+		{
+			const Dart nd = new_darts[2u * i];
+			const Dart ne = new_darts[2u * i + 1u];
+			result[i] = Vertex(nd);
+
+			if (emb_vertex)
+			{
+				this->attributes_[Vertex::ORBIT].ref_line(vertex_lines[i]);
+				this->attributes_[Vertex::ORBIT].ref_line(vertex_lines[i]);
+			}
+			if (emb_edge)
+			{
+				this->attributes_[Edge::ORBIT].ref_line(edge_lines[i]);
+				this->attributes_[Edge::ORBIT].ref_line(edge_lines[i]);
+			}
+			for (Dart d : { nd, ne })
+			{
+				const bool boundary = this->is_boundary(d);
+				if (emb_face && !boundary)
+					this->attributes_[Face::ORBIT].ref_line(this->embedding(Face(d)));
+				if (emb_volume)
+					this->attributes_[Volume::ORBIT].ref_line(this->embedding(Volume(d)));
+				if (this->template is_embedded<CDart>() && !boundary)
+					this->new_orbit_embedding(CDart(d));
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Flip a set of edges
+	 * @param edges : the edges to flip (they must be distinct)
+	 * The result is the same as flipping each edge with flip_edge. The edges are processed in rounds of edges
+	 * whose incident faces are disjoint: the flips of a round are done in parallel, the reference counters of
+	 * the attribute lines are then updated serially.
+	 */
+	void flip_edges(const std::vector<Edge>& edges)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const bool emb_vertex = this->template is_embedded<Vertex>();
+		const bool emb_face = this->template is_embedded<Face>();
+
+		// for each edge: the old vertex embeddings of d and phi2(d), the old face embeddings of their predecessors
+		std::vector<std::array<uint32, 4u>> old_emb(edges.size());
+		std::vector<uint8> flipped(edges.size(), 0u);
+
+		IndependentSetScheduler<Self> scheduler(*this, 0u);
+		scheduler.foreach_independent_set(edges, [&] (const std::vector<uint32>& round)
+		{
+			parallel_foreach_index(uint32(round.size()), [&] (uint32 k)
+			{
+				const uint32 i = round[k];
+				const Dart d = edges[i].dart;
+				if (!flip_edge_topo(d))
+					return;
+				flipped[i] = 1u;
+				const Dart d2 = phi2(d);
+
+				if (emb_vertex)
+				{
+					old_emb[i][0] = this->embedding(Vertex(d));
+					old_emb[i][1] = this->embedding(Vertex(d2));
+					this->template set_embedding_unreferenced<Vertex>(d, this->embedding(Vertex(this->phi1(d2))));
+					this->template set_embedding_unreferenced<Vertex>(d2, this->embedding(Vertex(this->phi1(d))));
+				}
+				if (emb_face)
+				{
+					old_emb[i][2] = this->embedding(Face(this->phi_1(d)));
+					old_emb[i][3] = this->embedding(Face(this->phi_1(d2)));
+					this->template set_embedding_unreferenced<Face>(this->phi_1(d), this->embedding(Face(d)));
+					this->template set_embedding_unreferenced<Face>(this->phi_1(d2), this->embedding(Face(d2)));
+				}
+			});
+
+			// ref the new lines before unrefing the old ones (as set_embedding)
+			for (uint32 i : round)
+			{
+				if (!flipped[i])
+					continue;
+				const Dart d = edges[i].dart;
+				const Dart d2 = phi2(d);
+				if (emb_vertex)
+				{
+					this->attributes_[Vertex::ORBIT].ref_line(this->embedding(Vertex(d)));
+					this->attributes_[Vertex::ORBIT].ref_line(this->embedding(Vertex(d2)));
+					this->attributes_[Vertex::ORBIT].unref_line(old_emb[i][0]);
+					this->attributes_[Vertex::ORBIT].unref_line(old_emb[i][1]);
+				}
+				if (emb_face)
+				{
+					this->attributes_[Face::ORBIT].ref_line(this->embedding(Face(d)));
+					this->attributes_[Face::ORBIT].ref_line(this->embedding(Face(d2)));
+					this->attributes_[Face::ORBIT].unref_line(old_emb[i][2]);
+					this->attributes_[Face::ORBIT].unref_line(old_emb[i][3]);
+				}
+			}
+		});
+	}
+
+protected:
+
+	/**
+	 * @brief Collapse an edge without removing the darts from the topology container
+	 * @param d : a dart of the edge to collapse
+	 * @param removed : filled with the darts that are detached from the map
+	 * @param nb_removed : number of darts of removed
+	 * @return a dart of the resulting vertex
+	 * The caller removes the darts of removed afterwards (several edges can then be collapsed concurrently).
+	 */
+	inline Dart collapse_edge_topo(Dart d, std::array<Dart, 6u>& removed, uint32& nb_removed)
+	{
+		nb_removed = 0u;
+		Dart d_1 = this->phi_1(d);
+		Dart e = phi2(d);
+		Dart e_1 = this->phi_1(e);
+
+		Dart res = phi2(d_1);
+
+		for (Dart v : { d, e })
+		{
+			const Dart v_1 = this->phi_1(v);
+			if (v_1 != v) this->phi1_unsew(v_1);
+			removed[nb_removed++] = v;
+		}
+
+		for (Dart f_1 : { d_1, e_1 })
+		{
+			if (codegree(Face(f_1)) == 2u)
+			{
+				Dart f1 = this->phi1(f_1);
+				Dart f12 = phi2(f1);
+				Dart f_12 = phi2(f_1);
+
+				phi2_unsew(f1);
+				phi2_unsew(f_1);
+
+				phi2_sew(f12, f_12);
+				removed[nb_removed++] = f1;
+				removed[nb_removed++] = f_1;
+			}
+		}
+
+		return res;
+	}
+
+public:
+
+	/**
+	 * @brief Collapse a set of edges
+	 * @param edges : the edges to collapse
+	 * @return the resulting vertices, in the order of the edges
+	 * The result is the same as collapsing each edge with collapse_edge: an edge must not be removed
+	 * by the collapse of another one (e.g. two edges of a same triangle).
+	 * The edges are processed in rounds of edges whose vertex stars are disjoint: the collapses of a round
+	 * are done in parallel, the attribute references and the removal of the darts are then done serially.
+	 */
+	std::vector<Vertex> collapse_edges(const std::vector<Edge>& edges)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const bool emb_vertex = this->template is_embedded<Vertex>();
+		const bool emb_edge = this->template is_embedded<Edge>();
+
+		std::vector<Vertex> result(edges.size());
+		// for each edge: the darts whose edge is re-embedded, the old vertex embedding and the count of re-embedded darts
+		std::vector<std::array<Dart, 2u>> edge_darts(edges.size());
+		std::vector<std::array<uint32, 2u>> vertex_emb(edges.size());
+		std::vector<uint32> nb_reembedded(edges.size(), 0u);
+		std::vector<std::array<Dart, 6u>> removed(edges.size());
+		std::vector<uint32> nb_removed(edges.size(), 0u);
+
+		IndependentSetScheduler<Self> scheduler(*this, 1u);
+		scheduler.foreach_independent_set(edges, [&] (const std::vector<uint32>& round)
+		{
+			parallel_foreach_index(uint32(round.size()), [&] (uint32 k)
+			{
+				const uint32 i = round[k];
+				const Dart d = edges[i].dart;
+				edge_darts[i] = {{ phi2(this->phi_1(d)), phi2(this->phi_1(phi2(d))) }};
+				if (emb_vertex)
+					vertex_emb[i][1] = this->embedding(Vertex(phi2(d)));
+
+				const Vertex v(collapse_edge_topo(d, removed[i], nb_removed[i]));
+				result[i] = v;
+
+				if (emb_vertex)
+				{
+					const uint32 emb = this->embedding(v);
+					vertex_emb[i][0] = emb;
+					this->foreach_dart_of_orbit(v, [&] (Dart vd)
+					{
+						if (this->embedding(Vertex(vd)) != emb)
+						{
+							cgogn_message_assert(this->embedding(Vertex(vd)) == vertex_emb[i][1], "collapse_edges: vertices not uniquely embedded");
+							this->template set_embedding_unreferenced<Vertex>(vd, emb);
+							++nb_reembedded[i];
+						}
+					});
+				}
+			});
+
+			for (uint32 i : round)
+			{
+				for (uint32 k = 0u; k < nb_reembedded[i]; ++k)
+					this->attributes_[Vertex::ORBIT].ref_line(vertex_emb[i][0]);
+				for (uint32 k = 0u; k < nb_reembedded[i]; ++k)
+					this->attributes_[Vertex::ORBIT].unref_line(vertex_emb[i][1]);
+
+				if (emb_edge)
+				{
+					this->template copy_embedding<Edge>(phi2(edge_darts[i][0]), edge_darts[i][0]);
+					this->template copy_embedding<Edge>(phi2(edge_darts[i][1]), edge_darts[i][1]);
+				}
+
+				for (uint32 k = 0u; k < nb_removed[i]; ++k)
+					this->remove_topology_element(removed[i][k]);
+			}
+		});
+
+		return result;
+	}
+
 protected:
 
 	inline void split_vertex_topo(Dart d, Dart e)
@@ -1696,7 +2018,7 @@ protected:
 	template <typename FUNC>
 	void foreach_dart_of_PHI1_PHI2(Dart d, const FUNC& f) const
 	{
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 
 		std::vector<Dart>* visited_faces = cgogn::dart_buffers()->buffer();
 		visited_faces->push_back(d); // Start with the face of d
@@ -1813,7 +2135,7 @@ public:
 	inline void foreach_incident_vertex(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1829,7 +2151,7 @@ public:
 	inline void foreach_incident_edge(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1845,7 +2167,7 @@ public:
 	inline void foreach_incident_face(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d) && !this->is_boundary(d))
@@ -2039,6 +2361,8 @@ extern template class CGOGN_CORE_API CMap2_T<CMap2Type>;
 extern template class CGOGN_CORE_API CMap2Builder_T<CMap2>;
 extern template class CGOGN_CORE_API DartMarker<CMap2>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap2>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap2>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap2>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2>;
 extern template class CGOGN_CORE_API CellMarker<CMap2, CMap2::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap2, CMap2::Edge::ORBIT>;
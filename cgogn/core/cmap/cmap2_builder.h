@@ -24,7 +24,12 @@
 #ifndef CGOGN_CORE_CMAP_CMAP2_BUILDER_H_
 #define CGOGN_CORE_CMAP_CMAP2_BUILDER_H_
 
+#include <atomic>
+#include <vector>
+
 #include <cgogn/core/cmap/map_base.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/utils/parallel_sort.h>
 
 namespace cgogn
 {
@@ -133,6 +138,129 @@ public:
 		return map_.close_map();
 	}
 
+	/**
+	 * @brief add and sew the faces described by flat index buffers (the faces are embedded on their vertices)
+	 * The chunks of all the darts are allocated at once and the faces are created in order, then the vertex
+	 * (and face) embeddings are written in parallel and phi2 is computed by a parallel sort of the
+	 * (min,max) vertex index pairs of the darts: in each group of darts of the same pair, the darts of opposite
+	 * orientations are sewn two by two, the other ones are left for the boundary.
+	 * The face i is embedded on the line i of the face container if the faces are embedded.
+	 * The faces that cannot be created by the map (e.g. non triangle faces in a CMap2Tri) are skipped.
+	 * @param faces_nb_edges number of vertices of each face
+	 * @param faces_vertex_indices indices of the vertices of the faces (lines of the vertex container), face after face
+	 * @param non_manifold set to true if an edge has more than two incident faces
+	 * @return the number of darts that are not sewn
+	 */
+	uint32 add_faces_bulk(const std::vector<uint32>& faces_nb_edges, const std::vector<uint32>& faces_vertex_indices, bool& non_manifold)
+	{
+		cgogn_message_assert(map_.template is_embedded<Vertex>(), "add_faces_bulk: the vertices must be embedded");
+
+		struct EdgeKey
+		{
+			uint64 vertices_; // (min << 32) | max
+			uint32 dart_;
+		};
+		const uint64 SKIPPED = std::numeric_limits<uint64>::max();
+
+		const uint32 nb_faces = uint32(faces_nb_edges.size());
+		const uint32 nb_darts = uint32(faces_vertex_indices.size());
+		std::vector<uint32> offsets(nb_faces + 1u);
+		offsets[0] = 0u;
+		for (uint32 i = 0u; i < nb_faces; ++i)
+			offsets[i + 1u] = offsets[i] + faces_nb_edges[i];
+		cgogn_message_assert(offsets[nb_faces] == nb_darts, "add_faces_bulk: wrong number of vertex indices");
+
+		// topology: all the chunks are allocated at once
+		map_.topology_.reserve(nb_darts);
+		std::vector<Dart> faces(nb_faces);
+		for (uint32 i = 0u; i < nb_faces; ++i)
+			faces[i] = map_.add_face_topo_fp(faces_nb_edges[i]);
+
+		// embeddings & keys of the darts (the refs of the lines are counted afterwards)
+		ChunkArray<uint32>* vertex_emb = map_.embeddings_[Vertex::ORBIT];
+		ChunkArray<uint32>* face_emb = map_.template is_embedded<Face>() ? map_.embeddings_[Face::ORBIT] : nullptr;
+		std::vector<EdgeKey> keys(nb_darts);
+		parallel_foreach_index(nb_faces, [&] (uint32 i)
+		{
+			Dart d = faces[i];
+			for (uint32 k = offsets[i], end = offsets[i + 1u]; k < end; ++k)
+			{
+				if (d.is_nil())
+				{
+					keys[k] = EdgeKey{SKIPPED, INVALID_INDEX};
+					continue;
+				}
+				const uint32 v = faces_vertex_indices[k];
+				const uint32 w = faces_vertex_indices[k + 1u < end ? k + 1u : offsets[i]];
+				(*vertex_emb)[d.index] = v;
+				if (face_emb)
+					(*face_emb)[d.index] = i;
+				keys[k] = EdgeKey{(uint64(std::min(v, w)) << 32) | uint64(std::max(v, w)), d.index};
+				d = map_.phi1(d);
+			}
+		});
+
+		ChunkArrayContainer<uint32>& vertex_container = attribute_container<Vertex::ORBIT>();
+		ChunkArrayContainer<uint32>& face_container = attribute_container<Face::ORBIT>();
+		for (uint32 i = 0u; i < nb_faces; ++i)
+		{
+			if (faces[i].is_nil())
+				continue;
+			for (uint32 k = offsets[i]; k < offsets[i + 1u]; ++k)
+			{
+				vertex_container.ref_line(faces_vertex_indices[k]);
+				if (face_emb)
+					face_container.ref_line(i);
+			}
+		}
+
+		// phi2: the darts of an edge are consecutive once sorted
+		parallel_sort(keys.begin(), keys.end(), [] (const EdgeKey& a, const EdgeKey& b)
+		{
+			return a.vertices_ < b.vertices_ || (a.vertices_ == b.vertices_ && a.dart_ < b.dart_);
+		});
+
+		const ChunkArray<uint32>& vertex_of = *vertex_emb;
+		std::atomic<uint32> nb_unsewn(0u);
+		std::atomic<bool> more_than_two(false);
+		parallel_foreach_index(nb_darts, [&] (uint32 k)
+		{
+			const uint64 key = keys[k].vertices_;
+			if (key == SKIPPED || (k > 0u && keys[k - 1u].vertices_ == key))
+				return;
+
+			// first dart of a group: pair the darts that go from min to max with the darts that go from max to min
+			uint32 end = k + 1u;
+			while (end < nb_darts && keys[end].vertices_ == key)
+				++end;
+			if (end - k > 2u)
+				more_than_two = true;
+
+			const uint32 min_vertex = uint32(key >> 32);
+			uint32 forward = k;
+			uint32 backward = k;
+			uint32 nb_sewn = 0u;
+			for (;;)
+			{
+				while (forward < end && vertex_of[keys[forward].dart_] != min_vertex)
+					++forward;
+				while (backward < end && vertex_of[keys[backward].dart_] == min_vertex)
+					++backward;
+				if (forward == end || backward == end)
+					break;
+				map_.phi2_sew(Dart(keys[forward].dart_), Dart(keys[backward].dart_));
+				nb_sewn += 2u;
+				++forward;
+				++backward;
+			}
+			if (end - k > nb_sewn)
+				nb_unsewn += end - k - nb_sewn;
+		});
+
+		non_manifold = more_than_two;
+		return nb_unsewn;
+	}
+
 	inline Dart add_topology_element()
 	{
 		return map_.add_topology_element();
@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap2Builder_T<CMap2Quad>;
 template class CGOGN_CORE_API DartMarker<CMap2Quad>;
 template class CGOGN_CORE_API DartMarkerStore<CMap2Quad>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap2Quad>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap2Quad>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2Quad>;
 template class CGOGN_CORE_API CellMarker<CMap2Quad, CMap2Quad::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap2Quad, CMap2Quad::Edge::ORBIT>;
@@ -75,6 +75,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -826,7 +828,7 @@ protected:
 	template <typename FUNC>
 	void foreach_dart_of_PHI1_PHI2(Dart d, const FUNC& f) const
 	{
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 
 		std::vector<Dart>* visited_faces = cgogn::dart_buffers()->buffer();
 		visited_faces->push_back(d); // Start with the face of d
@@ -970,7 +972,7 @@ public:
 	inline void foreach_incident_vertex(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -986,7 +988,7 @@ public:
 	inline void foreach_incident_edge(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1002,7 +1004,7 @@ public:
 	inline void foreach_incident_face(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d) && !this->is_boundary(d))
@@ -1196,6 +1198,8 @@ using CMap2Quad = CMap2Quad_T<CMap2QuadType>;
 extern template class CGOGN_CORE_API CMap2Builder_T<CMap2Quad>;
 extern template class CGOGN_CORE_API DartMarker<CMap2Quad>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap2Quad>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap2Quad>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap2Quad>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2Quad>;
 extern template class CGOGN_CORE_API CellMarker<CMap2Quad, CMap2Quad::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap2Quad, CMap2Quad::Edge::ORBIT>;
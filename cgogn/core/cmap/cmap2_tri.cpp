@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap2Builder_T<CMap2Tri>;
 template class CGOGN_CORE_API DartMarker<CMap2Tri>;
 template class CGOGN_CORE_API DartMarkerStore<CMap2Tri>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap2Tri>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap2Tri>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2Tri>;
 template class CGOGN_CORE_API CellMarker<CMap2Tri, CMap2Tri::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap2Tri, CMap2Tri::Edge::ORBIT>;
@@ -45,4 +47,23 @@ template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Edge::ORBIT>;
 template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Face::ORBIT>;
 template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Volume::ORBIT>;
 
+template class CGOGN_CORE_API CMap2Builder_T<CMap2TriCompact>;
+template class CGOGN_CORE_API DartMarker<CMap2TriCompact>;
+template class CGOGN_CORE_API DartMarkerStore<CMap2TriCompact>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap2TriCompact>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap2TriCompact>;
+template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2TriCompact>;
+template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
+
 } // namespace cgogn
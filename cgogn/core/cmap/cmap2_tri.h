@@ -37,6 +37,7 @@ public:
 
 	static const uint8 DIMENSION = 2;
 	static const uint8 PRIM_SIZE = 3;
+	static const bool COMPACT = MAP_TYPE::COMPACT;
 
 	using MapType = MAP_TYPE;
 	using Inherit = MapBase<MAP_TYPE>;
@@ -75,6 +76,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -92,6 +95,12 @@ protected:
 	inline void init()
 	{
 		phi2_ = this->topology_.template add_chunk_array<Dart>("phi2");
+		if (COMPACT)
+		{
+			// the boundary flag is packed in the high bit of phi2 (@see boundary_flag)
+			this->topology_.remove_marker_attribute(this->boundary_marker_);
+			this->boundary_marker_ = nullptr;
+		}
 	}
 
 public:
@@ -179,8 +188,8 @@ protected:
 	{
 		cgogn_assert(phi2(d) == d);
 		cgogn_assert(phi2(e) == e);
-		(*phi2_)[d.index] = e;
-		(*phi2_)[e.index] = d;
+		set_phi2(d, e);
+		set_phi2(e, d);
 	}
 
 	/**
@@ -192,8 +201,40 @@ protected:
 	inline void phi2_unsew(Dart d)
 	{
 		Dart e = phi2(d);
-		(*phi2_)[d.index] = d;
-		(*phi2_)[e.index] = e;
+		set_phi2(d, d);
+		set_phi2(e, e);
+	}
+
+	/**
+	 * \brief Set the phi2 relation of a dart, keeping its boundary flag in compact mode
+	 */
+	inline void set_phi2(Dart d, Dart e)
+	{
+		Dart& r = (*phi2_)[d.index];
+		r = COMPACT ? Dart(e.index | (r.index & Inherit::PACKED_FLAG_BIT)) : e;
+	}
+
+	/**
+	 * @brief boundary flag of a dart
+	 * In compact mode the flag is the high bit of the phi2 relation of the dart,
+	 * otherwise it is stored in the boundary marker of the map.
+	 */
+	inline bool boundary_flag(Dart d) const
+	{
+		if (COMPACT)
+			return ((*phi2_)[d.index].index & Inherit::PACKED_FLAG_BIT) != 0u;
+		return Inherit::boundary_flag(d);
+	}
+
+	inline void set_boundary_flag(Dart d, bool b)
+	{
+		if (COMPACT)
+		{
+			Dart& r = (*phi2_)[d.index];
+			r = b ? Dart(r.index | Inherit::PACKED_FLAG_BIT) : Dart(r.index & ~Inherit::PACKED_FLAG_BIT);
+		}
+		else
+			Inherit::set_boundary_flag(d, b);
 	}
 
 	/*******************************************************************************
@@ -239,6 +280,8 @@ public:
 	 */
 	inline Dart phi2(Dart d) const
 	{
+		if (COMPACT)
+			return Dart((*phi2_)[d.index].index & ~Inherit::PACKED_FLAG_BIT);
 		return (*phi2_)[d.index];
 	}
 
@@ -1123,7 +1166,7 @@ protected:
 	template <typename FUNC>
 	void foreach_dart_of_PHI1_PHI2(Dart d, const FUNC& f) const
 	{
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 
 		std::vector<Dart>* visited_faces = cgogn::dart_buffers()->buffer();
 		visited_faces->push_back(d); // Start with the face of d
@@ -1267,7 +1310,7 @@ public:
 	inline void foreach_incident_vertex(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1283,7 +1326,7 @@ public:
 	inline void foreach_incident_edge(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1299,7 +1342,7 @@ public:
 	inline void foreach_incident_face(Volume w, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(w, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d) && !this->is_boundary(d))
@@ -1485,14 +1528,28 @@ protected:
 struct CMap2TriType
 {
 	using TYPE = CMap2Tri_T<CMap2TriType>;
+	static const bool COMPACT = false;
+};
+
+/**
+ * @brief compact variant of CMap2Tri: the boundary flag of a dart is packed with its phi2 relation,
+ * that is read by the same memory access (no separate boundary marker)
+ */
+struct CMap2TriCompactType
+{
+	using TYPE = CMap2Tri_T<CMap2TriCompactType>;
+	static const bool COMPACT = true;
 };
 
 using CMap2Tri = CMap2Tri_T<CMap2TriType>;
+using CMap2TriCompact = CMap2Tri_T<CMap2TriCompactType>;
 
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_CMAP_CMAP2_TRI_CPP_))
 extern template class CGOGN_CORE_API CMap2Builder_T<CMap2Tri>;
 extern template class CGOGN_CORE_API DartMarker<CMap2Tri>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap2Tri>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap2Tri>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap2Tri>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2Tri>;
 extern template class CGOGN_CORE_API CellMarker<CMap2Tri, CMap2Tri::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap2Tri, CMap2Tri::Edge::ORBIT>;
@@ -1506,6 +1563,24 @@ extern template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Vertex:
 extern template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Edge::ORBIT>;
 extern template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Face::ORBIT>;
 extern template class CGOGN_CORE_API CellMarkerStore<CMap2Tri, CMap2Tri::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CMap2Builder_T<CMap2TriCompact>;
+extern template class CGOGN_CORE_API DartMarker<CMap2TriCompact>;
+extern template class CGOGN_CORE_API DartMarkerStore<CMap2TriCompact>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap2TriCompact>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap2TriCompact>;
+extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap2TriCompact>;
+extern template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap2TriCompact, CMap2TriCompact::Volume::ORBIT>;
 #endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_MAP_MAP2_CPP_))
 
 } // namespace cgogn
@@ -32,6 +32,8 @@ template class CGOGN_CORE_API CMap3_T<CMap3Type>;
 template class CGOGN_CORE_API CMap3Builder_T<CMap3>;
 template class CGOGN_CORE_API DartMarker<CMap3>;
 template class CGOGN_CORE_API DartMarkerStore<CMap3>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap3>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap3>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3>;
 template class CGOGN_CORE_API CellMarker<CMap3, CMap3::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap3, CMap3::Edge::ORBIT>;
@@ -80,6 +80,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -87,6 +89,8 @@ public:
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<Self, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerStore = typename cgogn::CellMarkerStore<Self, ORBIT>;
+	template <Orbit ORBIT>
+	using CellMarkerEpoch = typename cgogn::CellMarkerEpoch<Self, ORBIT>;
 
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
@@ -1705,13 +1709,14 @@ protected:
 	template <typename FUNC>
 	inline void foreach_dart_of_PHI21_PHI31(Dart d, const FUNC& f) const
 	{
-		DartMarkerStore marker(*this);
-		const std::vector<Dart>& marked_darts = marker.marked_darts();
+		DartMarkerLocal marker(*this);
+		std::vector<Dart>* visited_darts = cgogn::dart_buffers()->buffer();
 
 		marker.mark(d);
-		for(uint32 i = 0; i < marked_darts.size(); ++i)
+		visited_darts->push_back(d);
+		for(uint32 i = 0; i < visited_darts->size(); ++i)
 		{
-			const Dart curr_dart = marked_darts[i];
+			const Dart curr_dart = (*visited_darts)[i];
 			if ( !(this->is_boundary(curr_dart) && this->is_boundary(phi3(curr_dart))) )
 				if (!internal::void_to_true_binder(f, curr_dart))
 					break;
@@ -1721,10 +1726,18 @@ protected:
 			const Dart d3_1 = phi3(d_1); // change volume
 
 			if(!marker.is_marked(d2_1))
+			{
 				marker.mark(d2_1);
+				visited_darts->push_back(d2_1);
+			}
 			if(!marker.is_marked(d3_1))
+			{
 				marker.mark(d3_1);
+				visited_darts->push_back(d3_1);
+			}
 		}
+
+		cgogn::dart_buffers()->release_buffer(visited_darts);
 	}
 
 	template <typename FUNC>
@@ -1812,7 +1825,7 @@ public:
 	inline void foreach_incident_edge(Vertex v, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 		foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1828,7 +1841,7 @@ public:
 	inline void foreach_incident_face(Vertex v, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 		foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1845,7 +1858,7 @@ public:
 	inline void foreach_incident_volume(Vertex v, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Volume>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 		foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d) && !this->is_boundary(d))
@@ -1935,7 +1948,7 @@ public:
 	inline void foreach_incident_face(Volume v, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerLocal marker(*this);
 		foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1951,7 +1964,7 @@ public:
 	inline void foreach_incident_vertex(ConnectedComponent cc, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(cc, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1967,7 +1980,7 @@ public:
 	inline void foreach_incident_edge(ConnectedComponent cc, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(cc, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1983,7 +1996,7 @@ public:
 	inline void foreach_incident_face(ConnectedComponent cc, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(cc, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -1999,7 +2012,7 @@ public:
 	inline void foreach_incident_volume(ConnectedComponent cc, const FUNC& func) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Volume>::value, "Wrong function cell parameter type");
-		DartMarkerStore marker(*this);
+		DartMarkerEpoch marker(*this);
 		foreach_dart_of_orbit(cc, [&] (Dart d) -> bool
 		{
 			if (!marker.is_marked(d))
@@ -2630,6 +2643,8 @@ extern template class CGOGN_CORE_API CMap3_T<CMap3Type>;
 extern template class CGOGN_CORE_API CMap3Builder_T<CMap3>;
 extern template class CGOGN_CORE_API DartMarker<CMap3>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap3>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap3>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap3>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3>;
 extern template class CGOGN_CORE_API CellMarker<CMap3, CMap3::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap3, CMap3::Edge::ORBIT>;
@@ -94,6 +94,14 @@ public:
 		return map_.add_stamp_volume_topo_fp();
 	}
 
+	/**
+	 * @brief allocate at once the chunks of nb_darts darts that will be added to the map
+	 */
+	inline void reserve_darts(uint32 nb_darts)
+	{
+		map_.topology_.reserve(nb_darts);
+	}
+
 	template <class CellType>
 	inline void set_embedding(Dart d, uint32 emb)
 	{
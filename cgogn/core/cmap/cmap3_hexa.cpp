@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap3Builder_T<CMap3Hexa>;
 template class CGOGN_CORE_API DartMarker<CMap3Hexa>;
 template class CGOGN_CORE_API DartMarkerStore<CMap3Hexa>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap3Hexa>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap3Hexa>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3Hexa>;
 template class CGOGN_CORE_API CellMarker<CMap3Hexa, CMap3Hexa::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap3Hexa, CMap3Hexa::Edge::ORBIT>;
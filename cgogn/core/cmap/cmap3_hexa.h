@@ -78,6 +78,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -1730,6 +1732,8 @@ using CMap3Hexa = CMap3Hexa_T<CMap3HexaType>;
 extern template class CGOGN_CORE_API CMap3Builder_T<CMap3Hexa>;
 extern template class CGOGN_CORE_API DartMarker<CMap3Hexa>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap3Hexa>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap3Hexa>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap3Hexa>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3Hexa>;
 extern template class CGOGN_CORE_API CellMarker<CMap3Hexa, CMap3Hexa::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap3Hexa, CMap3Hexa::Edge::ORBIT>;
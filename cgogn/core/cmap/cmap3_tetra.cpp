@@ -31,6 +31,8 @@ namespace cgogn
 template class CGOGN_CORE_API CMap3Builder_T<CMap3Tetra>;
 template class CGOGN_CORE_API DartMarker<CMap3Tetra>;
 template class CGOGN_CORE_API DartMarkerStore<CMap3Tetra>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap3Tetra>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap3Tetra>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3Tetra>;
 template class CGOGN_CORE_API CellMarker<CMap3Tetra, CMap3Tetra::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<CMap3Tetra, CMap3Tetra::Edge::ORBIT>;
@@ -45,4 +47,23 @@ template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Edge::ORBI
 template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Face::ORBIT>;
 template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Volume::ORBIT>;
 
+template class CGOGN_CORE_API CMap3Builder_T<CMap3TetraCompact>;
+template class CGOGN_CORE_API DartMarker<CMap3TetraCompact>;
+template class CGOGN_CORE_API DartMarkerStore<CMap3TetraCompact>;
+template class CGOGN_CORE_API DartMarkerEpoch<CMap3TetraCompact>;
+template class CGOGN_CORE_API DartMarkerLocal<CMap3TetraCompact>;
+template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3TetraCompact>;
+template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
+
 } // namespace cgogn
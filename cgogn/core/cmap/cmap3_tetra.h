@@ -37,6 +37,7 @@ public:
 
 	static const uint8 DIMENSION = 3;
 	static const uint8 PRIM_SIZE = 12;
+	static const bool COMPACT = MAP_TYPE::COMPACT;
 
 	using MapType = MAP_TYPE;
 	using Inherit = MapBase<MAP_TYPE>;
@@ -78,6 +79,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 
 	template <Orbit ORBIT>
 	using CellMarker = typename cgogn::CellMarker<Self, ORBIT>;
@@ -95,6 +98,12 @@ protected:
 	inline void init()
 	{
 		phi3_ = this->topology_.template add_chunk_array<Dart>("phi3");
+		if (COMPACT)
+		{
+			// the boundary flag is packed in the high bit of phi3 (@see boundary_flag)
+			this->topology_.remove_marker_attribute(this->boundary_marker_);
+			this->boundary_marker_ = nullptr;
+		}
 	}
 
 public:
@@ -196,8 +205,8 @@ protected:
 	{
 		cgogn_assert(phi3(d) == d);
 		cgogn_assert(phi3(e) == e);
-		(*phi3_)[d.index] = e;
-		(*phi3_)[e.index] = d;
+		set_phi3(d, e);
+		set_phi3(e, d);
 	}
 
 	/**
@@ -209,8 +218,40 @@ protected:
 	inline void phi3_unsew(Dart d)
 	{
 		Dart e = phi3(d);
-		(*phi3_)[d.index] = d;
-		(*phi3_)[e.index] = e;
+		set_phi3(d, d);
+		set_phi3(e, e);
+	}
+
+	/**
+	 * \brief Set the phi3 relation of a dart, keeping its boundary flag in compact mode
+	 */
+	inline void set_phi3(Dart d, Dart e)
+	{
+		Dart& r = (*phi3_)[d.index];
+		r = COMPACT ? Dart(e.index | (r.index & Inherit::PACKED_FLAG_BIT)) : e;
+	}
+
+	/**
+	 * @brief boundary flag of a dart
+	 * In compact mode the flag is the high bit of the phi3 relation of the dart,
+	 * otherwise it is stored in the boundary marker of the map.
+	 */
+	inline bool boundary_flag(Dart d) const
+	{
+		if (COMPACT)
+			return ((*phi3_)[d.index].index & Inherit::PACKED_FLAG_BIT) != 0u;
+		return Inherit::boundary_flag(d);
+	}
+
+	inline void set_boundary_flag(Dart d, bool b)
+	{
+		if (COMPACT)
+		{
+			Dart& r = (*phi3_)[d.index];
+			r = b ? Dart(r.index | Inherit::PACKED_FLAG_BIT) : Dart(r.index & ~Inherit::PACKED_FLAG_BIT);
+		}
+		else
+			Inherit::set_boundary_flag(d, b);
 	}
 
 	/*******************************************************************************
@@ -276,6 +317,8 @@ public:
 	 */
 	inline Dart phi3(Dart d) const
 	{
+		if (COMPACT)
+			return Dart((*phi3_)[d.index].index & ~Inherit::PACKED_FLAG_BIT);
 		return (*phi3_)[d.index];
 	}
 
@@ -1632,14 +1675,28 @@ protected:
 struct CMap3TetraType
 {
 	using TYPE = CMap3Tetra_T<CMap3TetraType>;
+	static const bool COMPACT = false;
+};
+
+/**
+ * @brief compact variant of CMap3Tetra: the boundary flag of a dart is packed with its phi3 relation,
+ * that is read by the same memory access (no separate boundary marker)
+ */
+struct CMap3TetraCompactType
+{
+	using TYPE = CMap3Tetra_T<CMap3TetraCompactType>;
+	static const bool COMPACT = true;
 };
 
 using CMap3Tetra = CMap3Tetra_T<CMap3TetraType>;
+using CMap3TetraCompact = CMap3Tetra_T<CMap3TetraCompactType>;
 
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_CMAP_CMAP3_TETRA_CPP_))
 extern template class CGOGN_CORE_API CMap3Builder_T<CMap3Tetra>;
 extern template class CGOGN_CORE_API DartMarker<CMap3Tetra>;
 extern template class CGOGN_CORE_API DartMarkerStore<CMap3Tetra>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap3Tetra>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap3Tetra>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3Tetra>;
 extern template class CGOGN_CORE_API CellMarker<CMap3Tetra, CMap3Tetra::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<CMap3Tetra, CMap3Tetra::Edge::ORBIT>;
@@ -1653,6 +1710,24 @@ extern template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Ver
 extern template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Edge::ORBIT>;
 extern template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Face::ORBIT>;
 extern template class CGOGN_CORE_API CellMarkerStore<CMap3Tetra, CMap3Tetra::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CMap3Builder_T<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API DartMarker<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API DartMarkerStore<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API DartMarkerLocal<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API DartMarkerNoUnmark<CMap3TetraCompact>;
+extern template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarker<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerNoUnmark<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Vertex::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Edge::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Face::ORBIT>;
+extern template class CGOGN_CORE_API CellMarkerStore<CMap3TetraCompact, CMap3TetraCompact::Volume::ORBIT>;
 #endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_MAP_MAP2_CPP_))
 
 } // namespace cgogn
@@ -26,8 +26,12 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <fstream>
+#include <sstream>
 
 #include <cgogn/core/utils/masks.h>
+#include <cgogn/core/utils/reduction.h>
 #include <cgogn/core/utils/logger.h>
 #include <cgogn/core/utils/unique_ptr.h>
 #include <cgogn/core/utils/type_traits.h>
@@ -46,7 +50,8 @@ enum TraversalStrategy
 {
 	AUTO = 0,
 	FORCE_DART_MARKING,
-	FORCE_CELL_MARKING
+	FORCE_CELL_MARKING,
+	FORCE_CHUNK_SCAN
 };
 
 template <typename MAP_TYPE>
@@ -59,11 +64,17 @@ public:
 
 	template <typename MAP> friend class DartMarker_T;
 	template <typename MAP, Orbit ORBIT> friend class CellMarker_T;
+	template <typename MAP> friend class DartMarkerEpoch;
+	template <typename MAP, Orbit ORBIT> friend class CellMarkerEpoch;
 
 	using typename Inherit::ChunkArrayGen;
 	template <typename T>
 	using ChunkArray = typename Inherit::template ChunkArray<T>;
 	using typename Inherit::ChunkArrayBool;
+	using typename Inherit::ChunkArrayStamp;
+	using typename Inherit::MarkAttributePool;
+	template <typename T>
+	using ChunkArraySoA = typename Inherit::template ChunkArraySoA<T>;
 	template <typename T_REF>
 	using ChunkArrayContainer = typename Inherit::template ChunkArrayContainer<T_REF>;
 
@@ -71,10 +82,14 @@ public:
 
 	using DartMarker = cgogn::DartMarker<ConcreteMap>;
 	using DartMarkerStore = cgogn::DartMarkerStore<ConcreteMap>;
+	using DartMarkerEpoch = cgogn::DartMarkerEpoch<ConcreteMap>;
+	using DartMarkerLocal = cgogn::DartMarkerLocal<ConcreteMap>;
 
 	template <Orbit ORBIT>
 	using CellMarker = cgogn::CellMarker<ConcreteMap, ORBIT>;
 	template <Orbit ORBIT>
+	using CellMarkerEpoch = cgogn::CellMarkerEpoch<ConcreteMap, ORBIT>;
+	template <Orbit ORBIT>
 	using CellMarkerStore = cgogn::CellMarkerStore<ConcreteMap, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<ConcreteMap, ORBIT>;
@@ -116,6 +131,8 @@ public:
 			std::lock_guard<std::mutex> lock(this->mark_attributes_topology_mutex_);
 			for (ChunkArrayBool* cab : this->topology_.marker_arrays())
 				cab->clear();
+			for (ChunkArrayStamp* cas : this->topology_.stamp_arrays())
+				cas->clear();
 		}
 
 		for (std::size_t i = 0u; i < NB_ORBITS; ++i)
@@ -129,11 +146,252 @@ public:
 			std::lock_guard<std::mutex> lock(this->mark_attributes_mutex_[i]);
 			for (ChunkArrayBool* cab : this->attributes_[i].marker_arrays())
 				cab->clear();
+			for (ChunkArrayStamp* cas : this->attributes_[i].stamp_arrays())
+				cas->clear();
+		}
+	}
+
+	/**
+	 * @brief set the allocator of the chunks of the topology and attributes containers
+	 * Must be called before any element is added to the map (or after clear_and_remove_attributes).
+	 * With value_init == false, the attributes added later are not initialized (their values are
+	 * undefined until written), the topology is always fully initialized by the map.
+	 * @return false if one of the containers is not empty (its allocator is then unchanged)
+	 */
+	bool set_chunk_allocator(const ChunkAllocator& allocator)
+	{
+		bool result = this->topology_.set_chunk_allocator(allocator);
+		for (uint32 i = 0u; i < NB_ORBITS; ++i)
+			result &= this->attributes_[i].set_chunk_allocator(allocator);
+		return result;
+	}
+
+	/**
+	 * @brief save the map in a file that can be opened without copy by load_mapped
+	 * The file starts with a versioned header followed by the topology container, the boundary
+	 * marker and the attributes containers (@see ChunkArrayContainer::save_mapped).
+	 * The chunks are page aligned in the file and stored with the byte order of the system.
+	 * @param filename the name of the file
+	 * @return true if the file could be written
+	 */
+	bool save_mapped(const std::string& filename) const
+	{
+		std::ofstream fs(filename, std::ios::out | std::ios::binary);
+		if (!fs.good())
+		{
+			cgogn_log_error("save_mapped") << "Unable to open the file \"" << filename << "\".";
+			return false;
+		}
+
+		const uint32 alignment = uint32(ChunkAllocator::page_size());
+		const uint32 header[7] = {
+			MAPPED_FILE_VERSION, MAPPED_FILE_BYTE_ORDER, CHUNK_SIZE,
+			ConcreteMap::DIMENSION, ConcreteMap::PRIM_SIZE, NB_ORBITS, alignment
+		};
+		fs.write(mapped_file_magic(), 8);
+		fs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		this->topology_.save_mapped(fs, alignment);
+		if (this->boundary_marker_ != nullptr)
+			this->boundary_marker_->save(fs, this->topology_.end());
+		for (uint32 i = 0u; i < NB_ORBITS; ++i)
+			this->attributes_[i].save_mapped(fs, alignment);
+
+		return fs.good();
+	}
+
+	/**
+	 * @brief load a map saved by save_mapped
+	 * The file is mapped in memory (copy on write) and the chunks of the containers point into
+	 * the mapping: the data is read from the file when it is accessed and is duplicated in memory
+	 * only when it is modified, the file itself is never modified.
+	 * The map is cleared (all the existing attributes are removed) before loading.
+	 * @param filename the name of the file
+	 * @return false if the file could not be mapped or is not a valid file for this type of map
+	 */
+	bool load_mapped(const std::string& filename)
+	{
+		std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+		if (!file->open(filename))
+			return false;
+
+		std::ifstream fs(filename, std::ios::in | std::ios::binary);
+		char magic[8];
+		uint32 header[7];
+		fs.read(magic, sizeof(magic));
+		fs.read(reinterpret_cast<char*>(header), sizeof(header));
+		if (!fs.good() || !std::equal(magic, magic + 8, mapped_file_magic()) || header[0] != MAPPED_FILE_VERSION)
+		{
+			cgogn_log_error("load_mapped") << "The file \"" << filename << "\" is not a mapped map file of a known version.";
+			return false;
+		}
+		if (header[1] != MAPPED_FILE_BYTE_ORDER || header[2] != CHUNK_SIZE ||
+			header[3] != ConcreteMap::DIMENSION || header[4] != ConcreteMap::PRIM_SIZE || header[5] != NB_ORBITS)
+		{
+			cgogn_log_error("load_mapped") << "The file \"" << filename << "\" does not store a map of this type (or has another byte order).";
+			return false;
+		}
+		const uint32 alignment = header[6];
+
+		clear_and_remove_attributes();
+
+		bool result = this->topology_.load_mapped(fs, file, alignment);
+		if (this->boundary_marker_ != nullptr)
+		{
+			result = result && this->boundary_marker_->load(fs);
+			this->boundary_marker_->set_nb_chunks(this->topology_.nb_chunks());
+		}
+		for (uint32 i = 0u; i < NB_ORBITS && result; ++i)
+			result &= this->attributes_[i].load_mapped(fs, file, alignment);
+
+		if (!result)
+		{
+			cgogn_log_error("load_mapped") << "Unable to load the file \"" << filename << "\".";
+			clear_and_remove_attributes();
+			return false;
 		}
+
+		restore_embeddings();
+
+		return true;
+	}
+
+	/**
+	 * @brief enable or disable the tracking of the chunks modified in the topology and attributes containers
+	 * (Re)enabling the tracking clears the modification flags (@see save_delta).
+	 */
+	void set_dirty_tracking(bool b)
+	{
+		this->topology_.set_dirty_tracking(b);
+		for (uint32 i = 0u; i < NB_ORBITS; ++i)
+			this->attributes_[i].set_dirty_tracking(b);
+	}
+
+	/**
+	 * @brief save in a file the modifications of the map since the tracking was enabled or since the last save_delta
+	 * Only the modified chunks of the containers are written (@see ChunkArrayContainer::save_delta), the boundary
+	 * marker (one bit per dart) is written entirely. A checkpoint is a full save (e.g. save_mapped) followed
+	 * by the deltas, to be applied in the same order with apply_delta.
+	 * @param filename the name of the file
+	 * @return true if the file could be written
+	 * @pre the dirty tracking is enabled (@see set_dirty_tracking)
+	 */
+	bool save_delta(const std::string& filename)
+	{
+		std::ofstream fs(filename, std::ios::out | std::ios::binary);
+		if (!fs.good())
+		{
+			cgogn_log_error("save_delta") << "Unable to open the file \"" << filename << "\".";
+			return false;
+		}
+
+		const uint32 header[6] = {
+			DELTA_FILE_VERSION, MAPPED_FILE_BYTE_ORDER, CHUNK_SIZE,
+			ConcreteMap::DIMENSION, ConcreteMap::PRIM_SIZE, NB_ORBITS
+		};
+		fs.write(delta_file_magic(), 8);
+		fs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		this->topology_.save_delta(fs);
+		if (this->boundary_marker_ != nullptr)
+			this->boundary_marker_->save(fs, this->topology_.end());
+		for (uint32 i = 0u; i < NB_ORBITS; ++i)
+			this->attributes_[i].save_delta(fs);
+
+		return fs.good();
+	}
+
+	/**
+	 * @brief apply the modifications saved by save_delta
+	 * The map must be in the state of the saved one when the delta started.
+	 * @param filename the name of the file
+	 * @return false if the file is not a valid delta for this type of map (the map is then in an undefined state)
+	 */
+	bool apply_delta(const std::string& filename)
+	{
+		std::ifstream fs(filename, std::ios::in | std::ios::binary);
+		char magic[8];
+		uint32 header[6];
+		fs.read(magic, sizeof(magic));
+		fs.read(reinterpret_cast<char*>(header), sizeof(header));
+		if (!fs.good() || !std::equal(magic, magic + 8, delta_file_magic()) || header[0] != DELTA_FILE_VERSION)
+		{
+			cgogn_log_error("apply_delta") << "The file \"" << filename << "\" is not a delta file of a known version.";
+			return false;
+		}
+		if (header[1] != MAPPED_FILE_BYTE_ORDER || header[2] != CHUNK_SIZE ||
+			header[3] != ConcreteMap::DIMENSION || header[4] != ConcreteMap::PRIM_SIZE || header[5] != NB_ORBITS)
+		{
+			cgogn_log_error("apply_delta") << "The file \"" << filename << "\" does not store a delta of this type of map (or has another byte order).";
+			return false;
+		}
+
+		bool result = this->topology_.apply_delta(fs);
+		if (this->boundary_marker_ != nullptr)
+		{
+			result = result && this->boundary_marker_->load(fs);
+			this->boundary_marker_->set_nb_chunks(this->topology_.nb_chunks());
+		}
+		for (uint32 i = 0u; i < NB_ORBITS && result; ++i)
+			result &= this->attributes_[i].apply_delta(fs);
+
+		restore_embeddings();
+
+		if (!result)
+			cgogn_log_error("apply_delta") << "Unable to apply the file \"" << filename << "\".";
+		return result;
 	}
 
 protected:
 
+	/**
+	 * @brief update the darts stored in the dart arrays of the topology container after a move of the darts
+	 * @param old_new new index of the moved darts (0xffffffff for the unchanged ones)
+	 */
+	void remap_darts(const std::vector<uint32>& old_new)
+	{
+		for (ChunkArrayGen* ptr: this->topology_.chunk_arrays())
+		{
+			ChunkArray<Dart>* ca = dynamic_cast<ChunkArray<Dart>*>(ptr);
+			if (ca)
+			{
+				for (uint32 i=this->topology_.begin(); i!= this->topology_.end(); this->topology_.next(i))
+				{
+					Dart& d = (*ca)[i];
+					uint32 idx = d.index & ~PACKED_FLAG_BIT;
+					if (old_new[idx] != std::numeric_limits<uint32>::max())
+						d = Dart(old_new[idx] | (d.index & PACKED_FLAG_BIT));
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief restore the embeddings shortcuts from the arrays of the topology container
+	 */
+	void restore_embeddings()
+	{
+		for (uint32 i = 0u; i < NB_ORBITS; ++i)
+		{
+			std::ostringstream oss;
+			oss << "EMB_" << orbit_name(Orbit(i));
+			this->embeddings_[i] = this->topology_.template get_chunk_array<uint32>(oss.str());
+		}
+	}
+
+	static const uint32 DELTA_FILE_VERSION = 1u;
+	static const char* delta_file_magic()
+	{
+		return "CGoGNDLT";
+	}
+
+	static const uint32 MAPPED_FILE_VERSION = 1u;
+	static const uint32 MAPPED_FILE_BYTE_ORDER = 0x01020304u;
+	static const char* mapped_file_magic()
+	{
+		return "CGoGNMAP";
+	}
+
 	inline ConcreteMap* to_concrete()
 	{
 		return static_cast<ConcreteMap*>(this);
@@ -156,7 +414,10 @@ protected:
 	 */
 	inline Dart add_topology_element()
 	{
-		const uint32 idx = this->topology_.template insert_lines<ConcreteMap::PRIM_SIZE>();
+		const uint32 idx = this->topology_.concurrent_mode() ?
+			this->topology_.template insert_lines_concurrent<ConcreteMap::PRIM_SIZE>() :
+			this->topology_.template insert_lines<ConcreteMap::PRIM_SIZE>();
+		cgogn_message_assert(idx != INVALID_INDEX, "add_topology_element: the darts reserved by begin_concurrent_editing are exhausted");
 		for (uint32 jdx = idx; jdx < idx + ConcreteMap::PRIM_SIZE; ++jdx)
 		{
 			this->topology_.init_markers_of_line(jdx);
@@ -179,7 +440,10 @@ protected:
 	inline void remove_topology_element(Dart d)
 	{
 		uint32 index = d.index;
-		this->topology_.template remove_lines<ConcreteMap::PRIM_SIZE>(index);
+		if (this->topology_.concurrent_mode())
+			this->topology_.template remove_lines_concurrent<ConcreteMap::PRIM_SIZE>(index);
+		else
+			this->topology_.template remove_lines<ConcreteMap::PRIM_SIZE>(index);
 
 		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
 		{
@@ -200,7 +464,10 @@ protected:
 	{
 		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
 
-		uint32 idx = this->attributes_[ORBIT].template insert_lines<1>();
+		uint32 idx = this->attributes_[ORBIT].concurrent_mode() ?
+			this->attributes_[ORBIT].template insert_lines_concurrent<1>() :
+			this->attributes_[ORBIT].template insert_lines<1>();
+		cgogn_message_assert(idx != INVALID_INDEX, "add_attribute_element: the lines reserved by begin_concurrent_editing are exhausted");
 		this->attributes_[ORBIT].init_markers_of_line(idx);
 		return idx;
 	}
@@ -210,9 +477,56 @@ protected:
 	{
 		static_assert(ORBIT < NB_ORBITS,  "Unknown orbit parameter");
 
-		this->attributes_[ORBIT].template remove_lines<1>(index);
+		if (this->attributes_[ORBIT].concurrent_mode())
+			this->attributes_[ORBIT].template remove_lines_concurrent<1>(index);
+		else
+			this->attributes_[ORBIT].template remove_lines<1>(index);
+	}
+
+public:
+
+	/**
+	 * @brief enter the concurrent editing mode
+	 * Until end_concurrent_editing, the topological operations of the map can be called by several threads
+	 * at the same time on cells whose neighbourhoods do not overlap (@see IndependentSetScheduler):
+	 * the topology and attribute containers are in concurrent insertion mode, the darts and attribute lines
+	 * are added and removed concurrently and the updates of the reference counters of the lines are deferred.
+	 * Attributes and markers must not be added or removed and the numbers of cells are not updated
+	 * during the concurrent editing.
+	 * @param nb_darts maximum number of darts added during the concurrent editing
+	 * @param nb_lines maximum number of lines added in each attribute container of an embedded orbit
+	 */
+	void begin_concurrent_editing(uint32 nb_darts, uint32 nb_lines)
+	{
+		const uint32 nb_prim = (nb_darts + ConcreteMap::PRIM_SIZE - 1u) / ConcreteMap::PRIM_SIZE;
+		this->topology_.template begin_concurrent_insertions<ConcreteMap::PRIM_SIZE>(nb_prim * ConcreteMap::PRIM_SIZE);
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+		{
+			if (this->embeddings_[orbit])
+				this->attributes_[orbit].template begin_concurrent_insertions<1>(nb_lines);
+		}
+	}
+
+	/**
+	 * @brief leave the concurrent editing mode (@see begin_concurrent_editing)
+	 */
+	void end_concurrent_editing()
+	{
+		this->topology_.template end_concurrent_insertions<ConcreteMap::PRIM_SIZE>();
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+		{
+			if (this->attributes_[orbit].concurrent_mode())
+				this->attributes_[orbit].template end_concurrent_insertions<1>();
+		}
+	}
+
+	inline bool concurrent_editing() const
+	{
+		return this->topology_.concurrent_mode();
 	}
 
+protected:
+
 	//	template <Orbit ORBIT>
 	//	inline void compact_orbit_container()
 	//	{
@@ -266,6 +580,27 @@ public:
 		return this->add_attribute<T, CellType::ORBIT>(attribute_name);
 	}
 
+	/**
+	 * \brief add an attribute stored with a structure of arrays layout (one chunk per component)
+	 * @param attribute_name the name of the attribute to create
+	 * @return a handler to the created attribute
+	 */
+	template <typename T, Orbit ORBIT>
+	inline AttributeSoA<T, ORBIT> add_soa_attribute(const std::string& attribute_name)
+	{
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+		if (!this->template is_embedded<ORBIT>())
+			create_embedding<ORBIT>();
+		ChunkArraySoA<T>* ca = this->attributes_[ORBIT].template add_chunk_array_soa<T>(attribute_name);
+		return AttributeSoA<T, ORBIT>(this, ca);
+	}
+
+	template <typename T, typename CellType>
+	inline AttributeSoA<T, CellType::ORBIT> add_soa_attribute(const std::string& attribute_name)
+	{
+		return this->add_soa_attribute<T, CellType::ORBIT>(attribute_name);
+	}
+
 	/**
 	* \brief search an attribute for a given orbit
 	* @param attribute_name attribute name
@@ -301,6 +636,26 @@ public:
 		return Attribute_T<T>(const_cast<Self*>(this), ca, orbit);
 	}
 
+	/**
+	 * \brief search an attribute stored with a structure of arrays layout
+	 * @param attribute_name attribute name
+	 * @return an AttributeSoA (invalid if the attribute does not exist or is not stored as a ChunkArraySoA<T>)
+	 */
+	template <typename T, Orbit ORBIT>
+	inline AttributeSoA<T, ORBIT> get_soa_attribute(const std::string& attribute_name) const
+	{
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+
+		ChunkArraySoA<T>* ca = const_cast<Self*>(this)->attributes_[ORBIT].template get_chunk_array_soa<T>(attribute_name);
+		return AttributeSoA<T, ORBIT>(const_cast<Self*>(this), ca);
+	}
+
+	template <typename T, typename CellType>
+	inline AttributeSoA<T, CellType::ORBIT> get_soa_attribute(const std::string& attribute_name) const
+	{
+		return this->get_soa_attribute<T, CellType::ORBIT>(attribute_name);
+	}
+
 	/**
 	* \brief search an attribute for a given orbit and change its type (if size is compatible). First template arg is asked type, second is real type.
 	* @param attribute_name attribute name
@@ -327,6 +682,12 @@ public:
 		return this->attributes_[ah.orbit()].remove_chunk_array(ah.data());
 	}
 
+	template <typename T, Orbit ORBIT>
+	inline bool remove_attribute(const AttributeSoA<T, ORBIT>& ah)
+	{
+		return this->attributes_[ORBIT].remove_chunk_array(ah.data());
+	}
+
 	/**
 	 * \brief remove_attribute
 	 * @param orbit, the attribute orbit
@@ -376,17 +737,17 @@ protected:
 	{
 		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
 
-		const std::size_t thread = cgogn::current_thread_marker_index();
-		cgogn_assert(thread < mark_attributes_[ORBIT].size());
-
-		if (!this->mark_attributes_[ORBIT][thread].empty())
+		MarkAttributePool& pool = this->mark_pool(ORBIT);
+		++pool.churn.nb_acquired;
+		if (!pool.marks.empty())
 		{
-			ChunkArrayBool* ca = this->mark_attributes_[ORBIT][thread].back();
-			this->mark_attributes_[ORBIT][thread].pop_back();
+			ChunkArrayBool* ca = pool.marks.back();
+			pool.marks.pop_back();
 			return ca;
 		}
 		else
 		{
+			++pool.churn.nb_created;
 			std::lock_guard<std::mutex> lock(this->mark_attributes_mutex_[ORBIT]);
 			if (!this->template is_embedded<ORBIT>())
 				create_embedding<ORBIT>();
@@ -404,9 +765,53 @@ protected:
 	{
 		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
 		cgogn_message_assert(this->template is_embedded<ORBIT>(), "Invalid parameter: orbit not embedded");
-		cgogn_assert(cgogn::current_thread_marker_index() < mark_attributes_[ORBIT].size());
 
-		this->mark_attributes_[ORBIT][cgogn::current_thread_marker_index()].push_back(ca);
+		MarkAttributePool& pool = this->mark_pool(ORBIT);
+		++pool.churn.nb_released;
+		pool.marks.push_back(ca);
+	}
+
+	/**
+	* \brief get an epoch stamp attribute on the given ORBIT attribute container (from pool or created)
+	* @return a stamp attribute on the ORBIT attribute container, with no marked cell
+	*/
+	template <Orbit ORBIT>
+	inline ChunkArrayStamp* stamp_attribute()
+	{
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+
+		MarkAttributePool& pool = this->mark_pool(ORBIT);
+		++pool.churn.nb_acquired;
+		if (!pool.stamps.empty())
+		{
+			ChunkArrayStamp* ca = pool.stamps.back();
+			pool.stamps.pop_back();
+			return ca;
+		}
+		else
+		{
+			++pool.churn.nb_created;
+			std::lock_guard<std::mutex> lock(this->mark_attributes_mutex_[ORBIT]);
+			if (!this->template is_embedded<ORBIT>())
+				create_embedding<ORBIT>();
+			ChunkArrayStamp* ca = this->attributes_[ORBIT].add_stamp_attribute();
+			return ca;
+		}
+	}
+
+	/**
+	* \brief release an epoch stamp attribute on the given ORBIT attribute container
+	* @param the stamp attribute to release (its marks must have been cleared with unmark_all)
+	*/
+	template <Orbit ORBIT>
+	inline void release_stamp_attribute(ChunkArrayStamp* ca)
+	{
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+		cgogn_message_assert(this->template is_embedded<ORBIT>(), "Invalid parameter: orbit not embedded");
+
+		MarkAttributePool& pool = this->mark_pool(ORBIT);
+		++pool.churn.nb_released;
+		pool.stamps.push_back(ca);
 	}
 
 	/*******************************************************************************
@@ -727,14 +1132,41 @@ public:
 
 	inline bool is_boundary(Dart d) const
 	{
-		return (*this->boundary_marker_)[d.index];
+		return to_concrete()->boundary_flag(d);
 	}
 
 	inline void set_boundary(Dart d, bool b)
 	{
-		this->boundary_marker_->set_value(d.index, b);
+		to_concrete()->set_boundary_flag(d, b);
+	}
+
+protected:
+
+	/**
+	 * @brief flag that a compact map packs in the high bit of a dart relation (@see CMap2TriCompact)
+	 * The generic remappings of the dart arrays of the topology container preserve it.
+	 */
+	static const uint32 PACKED_FLAG_BIT = 0x80000000u;
+
+	/**
+	 * @brief boundary flag of a dart, stored in the boundary marker
+	 * The compact maps, that pack the flag with a dart relation, hide boundary_flag and set_boundary_flag.
+	 */
+	inline bool boundary_flag(Dart d) const
+	{
+		return (*this->boundary_marker_)[d.index];
+	}
+
+	inline void set_boundary_flag(Dart d, bool b)
+	{
+		if (this->topology_.concurrent_mode())
+			this->boundary_marker_->set_value_concurrent(d.index, b);
+		else
+			this->boundary_marker_->set_value(d.index, b);
 	}
 
+public:
+
 #pragma warning(push)
 #pragma warning(disable:4717)
 	template <Orbit ORBIT>
@@ -1002,6 +1434,7 @@ public:
 			case FORCE_CELL_MARKING :
 				foreach_cell_cell_marking(f, filter);
 				break;
+			case FORCE_CHUNK_SCAN : // only meaningful for parallel traversals
 			case AUTO :
 				if (this->template is_embedded<CellType>())
 					foreach_cell_cell_marking(f, filter);
@@ -1038,6 +1471,9 @@ public:
 			case FORCE_CELL_MARKING :
 				parallel_foreach_cell_cell_marking(f, filter);
 				break;
+			case FORCE_CHUNK_SCAN :
+				parallel_foreach_cell_chunk_scan(f, filter);
+				break;
 			case AUTO :
 				if (this->template is_embedded<CellType>())
 					parallel_foreach_cell_cell_marking(f, filter);
@@ -1195,6 +1631,56 @@ public:
 			dbuffs->release_cell_buffer(b);
 	}
 
+	/**
+	 * \brief parallel reduction over the cells of the map (boundary cells excluded)
+	 * the dimension of the traversed cells is determined based on the parameter of map_fn
+	 * each worker combines the values of its cells in its own (cache line padded) partial,
+	 * the partials are then combined with init in worker order
+	 * combine_fn must be associative and commutative (the distribution of cells among workers is not fixed)
+	 * @tparam T type of the reduced value
+	 * @tparam MapFunc type of the map function (CellType -> T)
+	 * @tparam CombineFunc type of the combination function ((T, T) -> T)
+	 * @param init initial value (first operand of the final combination)
+	 * @param map_fn the function applied to each cell
+	 * @param combine_fn the combination function
+	 * @return the combination of init with the values of all cells
+	 */
+	template <typename T, typename MapFunc, typename CombineFunc>
+	inline T parallel_reduce_cell(const T& init, const MapFunc& map_fn, const CombineFunc& combine_fn) const
+	{
+		using CellType = func_parameter_type<MapFunc>;
+
+		return parallel_reduce_cell(init, map_fn, combine_fn, [] (CellType) { return true; });
+	}
+
+	/**
+	 * \brief parallel reduction over the cells of the map selected by the given mask
+	 * @tparam MASK a filtering function (CellType -> bool), a CellFilters or a CellTraversor object
+	 * @see parallel_reduce_cell(const T&, const MapFunc&, const CombineFunc&)
+	 */
+	template <typename T, typename MapFunc, typename CombineFunc, typename MASK>
+	inline T parallel_reduce_cell(const T& init, const MapFunc& map_fn, const CombineFunc& combine_fn, const MASK& mask) const
+	{
+		using CellType = func_parameter_type<MapFunc>;
+
+		ThreadPool* thread_pool = cgogn::thread_pool();
+		if (thread_pool->nb_workers() == 0)
+		{
+			T result = init;
+			foreach_cell([&] (CellType c) { result = combine_fn(result, map_fn(c)); }, mask);
+			return result;
+		}
+
+		ReductionPartials<T> partials(thread_pool->max_nb_workers(), init);
+		parallel_foreach_cell([&] (CellType c)
+		{
+			partials.accumulate(current_thread_index(), map_fn(c), combine_fn);
+		},
+		mask);
+
+		return partials.result(init, combine_fn);
+	}
+
 protected:
 
 	/**
@@ -1213,7 +1699,7 @@ protected:
 		using CellType = func_parameter_type<FUNC>;
 
 		const ConcreteMap* cmap = to_concrete();
-		DartMarker dm(*cmap);
+		DartMarkerEpoch dm(*cmap);
 		for (Dart it = cmap->begin(), last = cmap->end(); it.index < last.index; cmap->next(it))
 		{
 			if (!dm.is_marked(it))
@@ -1258,7 +1744,7 @@ protected:
 		Buffers<Dart>* dbuffs = cgogn::dart_buffers();
 
 		const ConcreteMap* cmap = to_concrete();
-		DartMarker dm(*cmap);
+		DartMarkerEpoch dm(*cmap);
 		Dart it = cmap->begin();
 		Dart last = cmap->end();
 
@@ -1434,6 +1920,95 @@ protected:
 			dbuffs->release_cell_buffer(b);
 	}
 
+	/**
+	 * \brief apply a function in parallel on each cell of the map (boundary cells excluded)
+	 * the chunks of the topology container are distributed among the workers which scan them in parallel
+	 * (no dart is marked by the calling thread). Each cell is processed once by the worker that owns it :
+	 * - if the orbit is embedded, the first dart that atomically claims the cell index
+	 * - otherwise the non-boundary dart of the orbit that has the smallest index
+	 * the dart of the cell given to the function is thus not necessarily the one of a sequential traversal
+	 * only cells selected by the given FilterFunction (CellType -> bool) are processed
+	 * @tparam FUNC type of the callable
+	 * @tparam FilterFunction type of the cell filtering function (CellType -> bool)
+	 * @param f a callable
+	 * @param filter a cell filtering function
+	 */
+	template <typename FUNC, typename FilterFunction>
+	inline void parallel_foreach_cell_chunk_scan(const FUNC& f, const FilterFunction& filter) const
+	{
+		using CellType = func_parameter_type<FUNC>;
+		static const Orbit ORBIT = CellType::ORBIT;
+
+		ThreadPool* thread_pool = cgogn::thread_pool();
+		const uint32 nb_workers = thread_pool->nb_workers();
+		if (nb_workers == 0)
+			return foreach_cell<AUTO>(f, filter);
+
+		const ConcreteMap* cmap = to_concrete();
+		const uint32 last = this->topology_.end();
+		const uint32 nb_chunks = (last + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		std::atomic<uint32> next_chunk(0u);
+
+		if (this->template is_embedded<ORBIT>())
+		{
+			// one claim bit per cell index
+			const uint32 nb_lines = this->attributes_[ORBIT].end();
+			std::vector<std::atomic<uint32>> claimed((nb_lines + 31u) / 32u);
+			for (auto& w : claimed)
+				w.store(0u, std::memory_order_relaxed);
+
+			TaskGroup group;
+			for (uint32 w = 0u; w < nb_workers; ++w)
+			{
+				thread_pool->enqueue(group, [&] ()
+				{
+					for (uint32 k = next_chunk++; k < nb_chunks; k = next_chunk++)
+					{
+						for (uint32 i = k * CHUNK_SIZE, end = std::min(last, (k + 1u) * CHUNK_SIZE); i < end; ++i)
+						{
+							if (!this->topology_.used(i) || this->is_boundary(Dart(i)))
+								continue;
+							const CellType c((Dart(i)));
+							const uint32 emb = this->embedding(c);
+							const uint32 bit = 1u << (emb % 32u);
+							if ((claimed[emb / 32u].fetch_or(bit, std::memory_order_relaxed) & bit) == 0u && filter(c))
+								f(c);
+						}
+					}
+				});
+			}
+			group.wait();
+		}
+		else
+		{
+			TaskGroup group;
+			for (uint32 w = 0u; w < nb_workers; ++w)
+			{
+				thread_pool->enqueue(group, [&] ()
+				{
+					for (uint32 k = next_chunk++; k < nb_chunks; k = next_chunk++)
+					{
+						for (uint32 i = k * CHUNK_SIZE, end = std::min(last, (k + 1u) * CHUNK_SIZE); i < end; ++i)
+						{
+							if (!this->topology_.used(i) || this->is_boundary(Dart(i)))
+								continue;
+							bool owner = true;
+							const CellType c((Dart(i)));
+							cmap->foreach_dart_of_orbit(c, [&] (Dart d) -> bool
+							{
+								owner = d.index >= i || this->is_boundary(d);
+								return owner;
+							});
+							if (owner && filter(c))
+								f(c);
+						}
+					}
+				});
+			}
+			group.wait();
+		}
+	}
+
 public:
 
 	/*******************************************************************************
@@ -1469,20 +2044,7 @@ public:
 		if (old_new.empty())
 			return;			// already compact nothing to do with relationss
 
-		for (ChunkArrayGen* ptr: this->topology_.chunk_arrays())
-		{
-			ChunkArray<Dart>* ca = dynamic_cast<ChunkArray<Dart>*>(ptr);
-			if (ca)
-			{
-				for (uint32 i=this->topology_.begin(); i!= this->topology_.end(); this->topology_.next(i))
-				{
-					Dart& d = (*ca)[i];
-					uint32 idx = d.index;
-					if (old_new[idx] != std::numeric_limits<uint32>::max())
-						d = Dart(old_new[idx]);
-				}
-			}
-		}
+		remap_darts(old_new);
 	}
 
 	/**
@@ -1495,6 +2057,127 @@ public:
 			compact_embedding(orbit); // checking if embedding used done inside
 	}
 
+	/*******************************************************************************
+	 * reordering
+	 *******************************************************************************/
+
+	/**
+	 * @brief reorder the darts of the map (the holes of the topology container are removed)
+	 * The groups of PRIM_SIZE darts are stored in the order of the first occurrence of one of their darts in order.
+	 * The phi relations and the other dart arrays of the topology container are remapped, the embeddings, markers
+	 * and attributes handlers stay valid. The darts stored elsewhere (e.g. in attributes or caches) are not updated.
+	 * @param order all the darts of the map (at least one dart of each group) in their new order
+	 * @return false if order does not contain all the darts (the map is then unchanged)
+	 */
+	bool reorder_darts(const std::vector<Dart>& order)
+	{
+		const uint32 prim_size = ConcreteMap::PRIM_SIZE;
+		std::vector<uint32> groups;
+		groups.reserve(this->topology_.size() / prim_size);
+		std::vector<bool> seen(this->topology_.end(), false);
+		for (Dart d : order)
+		{
+			const uint32 g = d.index / prim_size * prim_size;
+			if (d.index < seen.size() && !seen[g])
+			{
+				seen[g] = true;
+				groups.push_back(g);
+			}
+		}
+
+		std::vector<uint32> old_new = this->topology_.template reorder<ConcreteMap::PRIM_SIZE>(groups);
+		if (old_new.empty())
+			return this->topology_.size() == 0u;
+
+		remap_darts(old_new);
+		return true;
+	}
+
+	/**
+	 * @brief reorder the cells of the given type in their attribute container (the holes are removed)
+	 * The embeddings of the darts are remapped, the attributes handlers stay valid.
+	 * @param order the indices (embeddings) of all the cells in their new order
+	 * @return false if the orbit is not embedded or if order does not contain all the cells (the map is then unchanged)
+	 */
+	template <typename CellType>
+	bool reorder_cells(const std::vector<uint32>& order)
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		if (!this->template is_embedded<ORBIT>())
+		{
+			cgogn_log_warning("reorder_cells") << "The orbit " << orbit_name(ORBIT) << " is not embedded.";
+			return false;
+		}
+
+		std::vector<uint32> old_new = this->attributes_[ORBIT].template reorder<1>(order);
+		if (old_new.empty())
+			return this->attributes_[ORBIT].size() == 0u;
+
+		ChunkArray<uint32>* embedding = this->embeddings_[ORBIT];
+		for (uint32 i = this->topology_.begin(); i != this->topology_.end(); this->topology_.next(i))
+		{
+			uint32& emb = (*embedding)[i];
+			if (emb != std::numeric_limits<uint32>::max())
+				emb = old_new[emb];
+		}
+		return true;
+	}
+
+	/**
+	 * @brief compute a Cuthill-McKee order of the darts for the graph of the dart arrays (phi relations)
+	 * As all the darts have the same number of phi relations, the ordering reduces to a breadth-first
+	 * traversal started from a pseudo-peripheral dart of each connected component (the last dart reached
+	 * by a first breadth-first traversal), the neighbors being visited in the order of the phi relations.
+	 * @return all the darts of the map (@see reorder_darts)
+	 */
+	std::vector<Dart> cuthill_mckee_dart_order() const
+	{
+		std::vector<const ChunkArray<Dart>*> relations;
+		for (const ChunkArrayGen* ptr : this->topology_.chunk_arrays())
+		{
+			const ChunkArray<Dart>* ca = dynamic_cast<const ChunkArray<Dart>*>(ptr);
+			if (ca)
+				relations.push_back(ca);
+		}
+
+		std::vector<Dart> order;
+		order.reserve(this->topology_.size());
+		// stamp of the last traversal that reached each dart
+		std::vector<uint32> stamp(this->topology_.end(), 0u);
+		std::vector<uint32> queue;
+		queue.reserve(this->topology_.size());
+		auto bfs = [&] (uint32 start, uint32 s)
+		{
+			queue.clear();
+			queue.push_back(start);
+			stamp[start] = s;
+			for (std::size_t head = 0u; head < queue.size(); ++head)
+			{
+				for (const ChunkArray<Dart>* phi : relations)
+				{
+					const uint32 n = (*phi)[queue[head]].index & ~PACKED_FLAG_BIT;
+					if (stamp[n] != s)
+					{
+						stamp[n] = s;
+						queue.push_back(n);
+					}
+				}
+			}
+		};
+
+		uint32 s = 0u;
+		for (uint32 i = this->topology_.begin(); i != this->topology_.end(); this->topology_.next(i))
+		{
+			if (stamp[i] != 0u)
+				continue;
+			bfs(i, ++s);
+			bfs(queue.back(), ++s);
+			for (uint32 d : queue)
+				order.push_back(Dart(d));
+		}
+		return order;
+	}
+
 	/**
 	 * @brief merge map in this map
 	 * @param map must be of same type than map
@@ -1537,9 +2220,9 @@ public:
 				for (uint32 i = first; i != this->topology_.end(); this->topology_.next(i))
 				{
 					Dart& d = (*cad)[i];
-					uint32 idx = d.index;
+					uint32 idx = d.index & ~PACKED_FLAG_BIT;
 					if (old_new_topo[idx] != INVALID_INDEX)
-						d = Dart(old_new_topo[idx]);
+						d = Dart(old_new_topo[idx] | (d.index & PACKED_FLAG_BIT));
 				}
 			}
 		}
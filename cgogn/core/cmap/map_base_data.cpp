@@ -48,20 +48,15 @@ MapBaseData::MapBaseData()
 
 	uint32 nb_mark_threads = thread_pool()->max_nb_workers() + external_thread_pool()->max_nb_workers() + 1; // +1 for main thread
 
+	// the pools are never resized afterwards (their elements are only accessed by their thread)
 	for (uint32 i = 0u; i < NB_ORBITS; ++i)
 	{
 		mark_attributes_[i].resize(nb_mark_threads);
-
 		embeddings_[i] = nullptr;
-		for (uint32 j = 0u; j < nb_mark_threads; ++j)
-			mark_attributes_[i][j].reserve(8u);
 	}
 
 	mark_attributes_topology_.resize(nb_mark_threads);
 
-	for (uint32 i = 0u; i < nb_mark_threads; ++i)
-		mark_attributes_topology_[i].reserve(8u);
-
 	boundary_marker_ = topology_.add_marker_attribute();
 }
 
@@ -80,4 +75,30 @@ MapBaseData::~MapBaseData()
 	}
 }
 
+MapBaseData::MarkerChurn MapBaseData::marker_churn() const
+{
+	MarkerChurn result{0u, 0u, 0u};
+	auto add = [&result] (const MarkAttributePool& pool)
+	{
+		result.nb_acquired += pool.churn.nb_acquired;
+		result.nb_released += pool.churn.nb_released;
+		result.nb_created += pool.churn.nb_created;
+	};
+	for (const MarkAttributePool& pool : mark_attributes_topology_)
+		add(pool);
+	for (const auto& pools : mark_attributes_)
+		for (const MarkAttributePool& pool : pools)
+			add(pool);
+	return result;
+}
+
+void MapBaseData::reset_marker_churn()
+{
+	for (MarkAttributePool& pool : mark_attributes_topology_)
+		pool.churn = MarkerChurn{0u, 0u, 0u};
+	for (auto& pools : mark_attributes_)
+		for (MarkAttributePool& pool : pools)
+			pool.churn = MarkerChurn{0u, 0u, 0u};
+}
+
 } // namespace cgogn
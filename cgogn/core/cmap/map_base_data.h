@@ -34,6 +34,7 @@
 #include <cgogn/core/utils/numerics.h>
 #include <cgogn/core/utils/thread.h>
 #include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/reduction.h>
 #include <cgogn/core/utils/name_types.h>
 #include <cgogn/core/container/chunk_array_container.h>
 #include <cgogn/core/basic/cell.h>
@@ -69,6 +70,7 @@ public:
 
 	template <typename T> friend class Attribute_T;
 	template <typename T, Orbit ORBIT> friend class Attribute;
+	template <typename T, Orbit ORBIT> friend class AttributeSoA;
 
 	template <typename T_REF>
 	using ChunkArrayContainer = cgogn::ChunkArrayContainer<CHUNK_SIZE, T_REF>;
@@ -76,8 +78,45 @@ public:
 	template <typename T>
 	using ChunkArray = cgogn::ChunkArray<CHUNK_SIZE, T>;
 	using ChunkArrayBool = cgogn::ChunkArrayBool<CHUNK_SIZE>;
+	using ChunkArrayStamp = cgogn::ChunkArrayStamp<CHUNK_SIZE>;
+	template <typename T>
+	using ChunkArraySoA = cgogn::ChunkArraySoA<CHUNK_SIZE, T>;
+
+	/**
+	 * @brief counters of the mark attributes (and epoch stamp attributes) requests
+	 * nb_acquired - nb_created is the number of requests served by the pools
+	 */
+	struct MarkerChurn
+	{
+		uint64 nb_acquired; // number of attributes given to a marker
+		uint64 nb_released; // number of attributes given back by a marker
+		uint64 nb_created;  // number of attributes added to a container (pool growth)
+	};
 
 protected:
+
+	/// initial capacity of the free lists (they do not reallocate while a thread uses less markers at once)
+	static const uint32 MARK_POOL_RESERVE = 16u;
+
+	/**
+	 * @brief free lists of the mark attributes of a container for one thread
+	 * A pool is only accessed by its thread: taking or giving back an attribute is lock-free.
+	 * The padding keeps the pools of two threads on different cache lines.
+	 */
+	struct MarkAttributePool
+	{
+		std::vector<ChunkArrayBool*> marks;
+		std::vector<ChunkArrayStamp*> stamps;
+		MarkerChurn churn;
+		char padding_[CACHE_LINE_SIZE];
+
+		MarkAttributePool() : churn{0u, 0u, 0u}
+		{
+			marks.reserve(MARK_POOL_RESERVE);
+			stamps.reserve(MARK_POOL_RESERVE);
+		}
+	};
+
 #pragma warning(push)
 #pragma warning(disable:4251)
 	// topology & embedding indices
@@ -92,12 +131,14 @@ protected:
 	// boundary marker shortcut
 	ChunkArrayBool* boundary_marker_;
 
-	// vector of available mark attributes per thread on the topology container
-	std::vector<std::vector<ChunkArrayBool*>> mark_attributes_topology_;
+	// pools of available mark attributes per thread on the topology container
+	std::vector<MarkAttributePool> mark_attributes_topology_;
+	// only taken to add a mark attribute to the topology container (when the pool of a thread is empty)
 	std::mutex mark_attributes_topology_mutex_;
 
-	// vector of available mark attributes per orbit per thread on attributes containers
-	std::array<std::vector<std::vector<ChunkArrayBool*>>, NB_ORBITS> mark_attributes_;
+	// pools of available mark attributes per orbit per thread on attributes containers
+	std::array<std::vector<MarkAttributePool>, NB_ORBITS> mark_attributes_;
+	// only taken to add a mark attribute to an attribute container (when the pool of a thread is empty)
 	std::array<std::mutex, NB_ORBITS> mark_attributes_mutex_;
 
 	// vector of Map instances
@@ -161,16 +202,17 @@ protected:
 	*/
 	inline ChunkArrayBool* topology_mark_attribute()
 	{
-		const std::size_t thread = cgogn::current_thread_marker_index();
-		cgogn_assert(thread < mark_attributes_topology_.size());
-		if (!this->mark_attributes_topology_[thread].empty())
+		MarkAttributePool& pool = topology_mark_pool();
+		++pool.churn.nb_acquired;
+		if (!pool.marks.empty())
 		{
-			ChunkArrayBool* ca = this->mark_attributes_topology_[thread].back();
-			this->mark_attributes_topology_[thread].pop_back();
+			ChunkArrayBool* ca = pool.marks.back();
+			pool.marks.pop_back();
 			return ca;
 		}
 		else
 		{
+			++pool.churn.nb_created;
 			std::lock_guard<std::mutex> lock(this->mark_attributes_topology_mutex_);
 			ChunkArrayBool* ca = this->topology_.add_marker_attribute();
 			return ca;
@@ -182,12 +224,82 @@ protected:
 	* @param the mark attribute to release
 	*/
 	inline void release_topology_mark_attribute(ChunkArrayBool* ca)
+	{
+		MarkAttributePool& pool = topology_mark_pool();
+		++pool.churn.nb_released;
+		pool.marks.push_back(ca);
+	}
+
+	/**
+	* \brief get an epoch stamp attribute on the topology container (from pool or created)
+	* @return a stamp attribute on the topology container, with no marked dart
+	*/
+	inline ChunkArrayStamp* topology_stamp_attribute()
+	{
+		MarkAttributePool& pool = topology_mark_pool();
+		++pool.churn.nb_acquired;
+		if (!pool.stamps.empty())
+		{
+			ChunkArrayStamp* ca = pool.stamps.back();
+			pool.stamps.pop_back();
+			return ca;
+		}
+		else
+		{
+			++pool.churn.nb_created;
+			std::lock_guard<std::mutex> lock(this->mark_attributes_topology_mutex_);
+			ChunkArrayStamp* ca = this->topology_.add_stamp_attribute();
+			return ca;
+		}
+	}
+
+	/**
+	* \brief release an epoch stamp attribute on the topology container
+	* @param the stamp attribute to release (its marks must have been cleared with unmark_all)
+	*/
+	inline void release_topology_stamp_attribute(ChunkArrayStamp* ca)
+	{
+		MarkAttributePool& pool = topology_mark_pool();
+		++pool.churn.nb_released;
+		pool.stamps.push_back(ca);
+	}
+
+	/**
+	* \brief get the pool of mark attributes of the topology container of the calling thread
+	*/
+	inline MarkAttributePool& topology_mark_pool()
 	{
 		const std::size_t thread = cgogn::current_thread_marker_index();
 		cgogn_assert(thread < mark_attributes_topology_.size());
-		this->mark_attributes_topology_[thread].push_back(ca);
+		return mark_attributes_topology_[thread];
 	}
 
+	/**
+	* \brief get the pool of mark attributes of the given orbit container of the calling thread
+	*/
+	inline MarkAttributePool& mark_pool(Orbit orbit)
+	{
+		const std::size_t thread = cgogn::current_thread_marker_index();
+		cgogn_assert(thread < mark_attributes_[orbit].size());
+		return mark_attributes_[orbit][thread];
+	}
+
+public:
+
+	/**
+	 * \brief counters of the requests of mark attributes (all threads, all containers) since the creation of the map
+	 * or the last call to reset_marker_churn
+	 * The counters are updated without synchronization: call it when no marker is created or destroyed concurrently.
+	 */
+	MarkerChurn marker_churn() const;
+
+	/**
+	 * \brief reset the counters of the requests of mark attributes
+	 */
+	void reset_marker_churn();
+
+protected:
+
 	/*******************************************************************************
 	 * Embedding (orbit indexing) management
 	 *******************************************************************************/
@@ -261,6 +373,21 @@ protected:
 		this->template set_embedding<CellType>(dest, embedding(CellType(src)));
 	}
 
+	/**
+	 * @brief set the embedding of a dart without updating the reference counters of the attribute lines
+	 * It can be called concurrently on distinct darts (@see CMap2_T::cut_edges),
+	 * the counters must then be updated with ref_line() and unref_line().
+	 */
+	template <class CellType>
+	inline void set_embedding_unreferenced(Dart d, uint32 emb)
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+		cgogn_message_assert(is_embedded<ORBIT>(), "Invalid parameter: orbit not embedded");
+
+		(*embeddings_[ORBIT])[d.index] = emb;
+	}
+
 };
 
 } // namespace cgogn
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#include <cgogn/core/container/chunk_allocator.h>
+
+namespace cgogn
+{
+
+std::size_t ChunkAllocator::page_size()
+{
+#if defined(__linux__)
+	static const std::size_t size = std::size_t(sysconf(_SC_PAGESIZE));
+	return size;
+#else
+	return 4096u;
+#endif
+}
+
+void* ChunkAllocator::allocate_aligned(std::size_t size, std::size_t alignment)
+{
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, alignment);
+#else
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, alignment, size) != 0)
+		return nullptr;
+	return ptr;
+#endif
+}
+
+void ChunkAllocator::free_aligned(void* ptr)
+{
+#if defined(_MSC_VER)
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+void ChunkAllocator::advise_huge_pages(void* ptr, std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	madvise(ptr, size, MADV_HUGEPAGE);
+#else
+	unused_parameters(ptr, size);
+#endif
+}
+
+void ChunkAllocator::interleave(void* ptr, std::size_t size)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+	const int MPOL_INTERLEAVE_POLICY = 3;
+	const unsigned long MPOL_F_MEMS_ALLOWED_FLAG = 1ul << 2;
+	unsigned long nodes = 0ul;
+	if (syscall(SYS_get_mempolicy, nullptr, &nodes, 8ul * sizeof(nodes), nullptr, MPOL_F_MEMS_ALLOWED_FLAG) != 0 || nodes == 0ul)
+		return;
+	syscall(SYS_mbind, ptr, size, MPOL_INTERLEAVE_POLICY, &nodes, 8ul * sizeof(nodes), 0u);
+#else
+	unused_parameters(ptr, size);
+#endif
+}
+
+} // namespace cgogn
@@ -0,0 +1,226 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_CONTAINER_CHUNK_ALLOCATOR_H_
+#define CGOGN_CORE_CONTAINER_CHUNK_ALLOCATOR_H_
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+
+#include <cgogn/core/dll.h>
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/definitions.h>
+#include <cgogn/core/utils/assert.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief placement policy of the chunks of a ChunkArray
+ */
+enum class ChunkAllocationMode : uint32
+{
+	/// new T[CHUNK_SIZE] (default behaviour)
+	DEFAULT = 0,
+	/// page aligned chunks, advised to be backed by transparent huge pages (Linux, madvise)
+	HUGE_PAGES,
+	/// page aligned chunks whose pages are first touched by the pool workers instead of the thread that grows the container
+	FIRST_TOUCH,
+	/// page aligned chunks whose pages are interleaved on all the allowed NUMA nodes (Linux, mbind)
+	INTERLEAVED
+};
+
+/**
+ * @brief allocator of the chunks of the ChunkArray of a ChunkArrayContainer
+ * The allocator is a small value type (a mode and an initialization policy) copied into each array:
+ * a chunk is always released by the allocator that created it.
+ * When value_init is false, the elements of the new chunks are default-initialized instead of
+ * value-initialized: for trivially constructible types (arithmetic values, std::array, Eigen vectors)
+ * the memory of the chunk is not written at all, which is useful when the chunk is known to be
+ * overwritten and, with FIRST_TOUCH, leaves the placement of the pages to their first writer.
+ */
+class CGOGN_CORE_API ChunkAllocator
+{
+public:
+
+	inline ChunkAllocator(ChunkAllocationMode mode = ChunkAllocationMode::DEFAULT, bool value_init = true) :
+		mode_(mode),
+		value_init_(value_init)
+	{}
+
+	inline ChunkAllocationMode mode() const { return mode_; }
+
+	inline bool value_init() const { return value_init_; }
+
+	inline bool operator==(const ChunkAllocator& a) const { return mode_ == a.mode_ && value_init_ == a.value_init_; }
+
+	inline bool operator!=(const ChunkAllocator& a) const { return !(*this == a); }
+
+	/**
+	 * @brief allocate and initialize a chunk of nb elements
+	 */
+	template <typename T>
+	T* allocate(uint32 nb) const
+	{
+		T* chunk = allocate_uninitialized<T>(nb);
+		if (mode_ != ChunkAllocationMode::DEFAULT)
+			initialize(chunk, 0u, nb);
+		return chunk;
+	}
+
+	/**
+	 * @brief allocate and initialize several chunks of nb elements
+	 * In FIRST_TOUCH mode, the initialization of the chunks is distributed on the workers of the thread pool.
+	 * @param chunks filled with the new chunks
+	 */
+	template <typename T>
+	void allocate(uint32 nb, std::vector<T*>& chunks, uint32 nb_chunks) const
+	{
+		const std::size_t first = chunks.size();
+		for (uint32 i = 0u; i < nb_chunks; ++i)
+			chunks.push_back(allocate_uninitialized<T>(nb));
+
+		if (mode_ == ChunkAllocationMode::DEFAULT)
+			return;
+
+		ThreadPool* pool = thread_pool();
+		// nested parallelism is avoided : workers initialize their chunks themselves
+		if (mode_ != ChunkAllocationMode::FIRST_TOUCH || pool->nb_workers() == 0u || current_thread_marker_index() != 0u || nb_chunks < 2u)
+		{
+			for (std::size_t i = first; i < chunks.size(); ++i)
+				initialize(chunks[i], 0u, nb);
+			return;
+		}
+
+		std::atomic<std::size_t> next(first);
+		const std::size_t end = chunks.size();
+		TaskGroup group;
+		for (uint32 w = 0u, nbw = std::min(pool->nb_workers(), nb_chunks); w < nbw; ++w)
+		{
+			pool->enqueue(group, [this, &chunks, &next, end, nb] ()
+			{
+				for (std::size_t i = next++; i < end; i = next++)
+					initialize(chunks[i], 0u, nb);
+			});
+		}
+		group.wait();
+	}
+
+	/**
+	 * @brief destroy the elements of a chunk of nb elements and release its memory
+	 */
+	template <typename T>
+	void deallocate(T* chunk, uint32 nb) const
+	{
+		if (mode_ == ChunkAllocationMode::DEFAULT)
+		{
+			delete[] chunk;
+			return;
+		}
+		if (!std::is_trivially_destructible<T>::value)
+		{
+			for (uint32 i = 0u; i < nb; ++i)
+				chunk[i].~T();
+		}
+		free_aligned(chunk);
+	}
+
+	/**
+	 * @brief page size used to align the chunks
+	 */
+	static std::size_t page_size();
+
+	/**
+	 * @brief size of the (transparent) huge pages, chunks larger than that are aligned on it in HUGE_PAGES mode
+	 */
+	static std::size_t huge_page_size()
+	{
+		return std::size_t(2u * 1024u * 1024u);
+	}
+
+private:
+
+	template <typename T>
+	T* allocate_uninitialized(uint32 nb) const
+	{
+		if (mode_ == ChunkAllocationMode::DEFAULT)
+			return value_init_ ? new T[nb]() : new T[nb];
+
+		const std::size_t bytes = std::size_t(nb) * sizeof(T);
+		const std::size_t alignment = (mode_ == ChunkAllocationMode::HUGE_PAGES && bytes >= huge_page_size()) ? huge_page_size() : page_size();
+		const std::size_t size = (bytes + alignment - 1u) / alignment * alignment;
+		void* ptr = allocate_aligned(size, alignment);
+		if (ptr == nullptr)
+			throw std::bad_alloc();
+
+		if (mode_ == ChunkAllocationMode::HUGE_PAGES)
+			advise_huge_pages(ptr, size);
+		else if (mode_ == ChunkAllocationMode::INTERLEAVED)
+			interleave(ptr, size);
+
+		return static_cast<T*>(ptr);
+	}
+
+	template <typename T>
+	void initialize(T* chunk, uint32 begin, uint32 end) const
+	{
+		if (value_init_)
+		{
+			for (uint32 i = begin; i < end; ++i)
+				new (chunk + i) T();
+		}
+		else
+		{
+			for (uint32 i = begin; i < end; ++i)
+				new (chunk + i) T;
+		}
+	}
+
+	static void* allocate_aligned(std::size_t size, std::size_t alignment);
+
+	static void free_aligned(void* ptr);
+
+	/**
+	 * @brief advise the system to back a memory area with (transparent) huge pages (Linux, no-op elsewhere)
+	 */
+	static void advise_huge_pages(void* ptr, std::size_t size);
+
+	/**
+	 * @brief set the NUMA policy of the (not yet touched) pages of a memory area to interleave on the allowed nodes
+	 * No-op when the system calls are not available (the pages are then placed by first touch).
+	 */
+	static void interleave(void* ptr, std::size_t size);
+
+	ChunkAllocationMode mode_;
+	bool value_init_;
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_CONTAINER_CHUNK_ALLOCATOR_H_
@@ -35,5 +35,7 @@ template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, uint8>;
 template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, std::array<float32, 3>>;
 template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, std::array<float64, 3>>;
 template class CGOGN_CORE_API ChunkArrayBool<CGOGN_CHUNK_SIZE>;
+template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, uint16>;
+template class CGOGN_CORE_API ChunkArrayStamp<CGOGN_CHUNK_SIZE>;
 
 } // namespace cgogn
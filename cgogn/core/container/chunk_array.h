@@ -26,9 +26,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <memory>
+#include <type_traits>
 
 #include <cgogn/core/dll.h>
 #include <cgogn/core/container/chunk_array_gen.h>
@@ -63,18 +66,26 @@ protected:
 	// vector of block pointers
 	std::vector<T*> table_data_;
 
+	// number of chunks (at the beginning of table_data_) that are stored in a mapped file
+	uint32 nb_mapped_chunks_;
+
+	// mapped file of the mapped chunks
+	std::shared_ptr<MappedFile> mapped_file_;
+
 public:
 
 	/**
 	 * @brief Constructor of ChunkArray
 	 */
 	inline ChunkArray(const std::string& name) :
-		Inherit(name, name_of_type(T()))
+		Inherit(name, name_of_type(T())),
+		nb_mapped_chunks_(0u)
 	{
 		table_data_.reserve(1024u);
 	}
 
-	inline ChunkArray() : Inherit("",name_of_type(T()))
+	inline ChunkArray() : Inherit("",name_of_type(T())),
+		nb_mapped_chunks_(0u)
 	{
 		table_data_.reserve(1024u);
 	}
@@ -83,8 +94,8 @@ public:
 
 	~ChunkArray() override
 	{
-		for(auto chunk : table_data_)
-			delete[] chunk;
+		for (std::size_t i = nb_mapped_chunks_; i < table_data_.size(); ++i)
+			this->allocator_.deallocate(table_data_[i], CHUNK_SIZE);
 	}
 
 	std::string nested_type_name() const override
@@ -121,6 +132,24 @@ public:
 		return uint32(table_data_.size())*CHUNK_SIZE;
 	}
 
+	/**
+	 * @brief get the data of a chunk
+	 * @param chunk index of the chunk
+	 * @return pointer on the CHUNK_SIZE elements of the chunk
+	 */
+	inline T* chunk_data(uint32 chunk)
+	{
+		cgogn_message_assert(chunk < table_data_.size(), "chunk_data: chunk index out of bounds");
+		this->mark_dirty(chunk);
+		return table_data_[chunk];
+	}
+
+	inline const T* chunk_data(uint32 chunk) const
+	{
+		cgogn_message_assert(chunk < table_data_.size(), "chunk_data: chunk index out of bounds");
+		return table_data_[chunk];
+	}
+
 	/**
 	 * @brief return a vector with pointers to all chunks
 	 * @param byte_chunk_size filled with CHUNK_SIZE*sizeof(T)
@@ -159,6 +188,11 @@ public:
 			return false;
 		}
 		table_data_.swap(ca->table_data_);
+		std::swap(this->allocator_, ca->allocator_);
+		std::swap(nb_mapped_chunks_, ca->nb_mapped_chunks_);
+		mapped_file_.swap(ca->mapped_file_);
+		this->mark_all_dirty();
+		ca->mark_all_dirty();
 		return true;
 	}
 
@@ -167,7 +201,8 @@ public:
 	 */
 	void add_chunk() override
 	{
-		table_data_.push_back(new T[CHUNK_SIZE]());
+		table_data_.push_back(this->allocator_.template allocate<T>(CHUNK_SIZE));
+		this->resize_dirty_flags(uint32(table_data_.size()));
 	}
 
 	/**
@@ -178,15 +213,19 @@ public:
 	{
 		if (nbc >= table_data_.size())
 		{
-			for (std::size_t i = table_data_.size(); i < nbc; ++i)
-				add_chunk();
+			// chunks are allocated at once to let the allocator spread their initialization on the thread pool
+			this->allocator_.allocate(CHUNK_SIZE, table_data_, nbc - uint32(table_data_.size()));
 		}
 		else
 		{
-			for (std::size_t i = static_cast<std::size_t>(nbc); i < table_data_.size(); ++i)
-				delete[] table_data_[i];
+			for (std::size_t i = std::max(nbc, nb_mapped_chunks_); i < table_data_.size(); ++i)
+				this->allocator_.deallocate(table_data_[i], CHUNK_SIZE);
 			table_data_.resize(nbc);
+			nb_mapped_chunks_ = std::min(nb_mapped_chunks_, nbc);
+			if (nb_mapped_chunks_ == 0u)
+				mapped_file_.reset();
 		}
+		this->resize_dirty_flags(nbc);
 	}
 
 	/**
@@ -194,11 +233,55 @@ public:
 	 */
 	void clear() override
 	{
-		for(auto chunk : table_data_)
-			delete[] chunk;
+		for (std::size_t i = nb_mapped_chunks_; i < table_data_.size(); ++i)
+			this->allocator_.deallocate(table_data_[i], CHUNK_SIZE);
 		table_data_.clear();
 		table_data_.shrink_to_fit();
 		table_data_.reserve(1024u);
+		nb_mapped_chunks_ = 0u;
+		mapped_file_.reset();
+		this->resize_dirty_flags(0u);
+	}
+
+	/**
+	 * @brief types without resources to release (no pointer to owned memory) can be mapped
+	 */
+	bool is_mappable() const override
+	{
+		return std::is_trivially_destructible<T>::value;
+	}
+
+	bool attach_mapped_chunks(const std::vector<char*>& chunks, const std::shared_ptr<MappedFile>& file) override
+	{
+		if (!is_mappable())
+			return false;
+		clear();
+		for (char* chunk : chunks)
+			table_data_.push_back(reinterpret_cast<T*>(chunk));
+		nb_mapped_chunks_ = uint32(chunks.size());
+		mapped_file_ = file;
+		this->mark_all_dirty();
+		return true;
+	}
+
+	void save_raw_chunk(std::ostream& fs, uint32 chunk) const override
+	{
+		cgogn_assert(is_mappable() && chunk < table_data_.size());
+		fs.write(reinterpret_cast<const char*>(table_data_[chunk]), std::streamsize(CHUNK_SIZE * sizeof(T)));
+	}
+
+	bool load_raw_chunk(std::istream& fs, uint32 chunk) override
+	{
+		if (!is_mappable() || chunk >= table_data_.size())
+			return false;
+		fs.read(reinterpret_cast<char*>(table_data_[chunk]), std::streamsize(CHUNK_SIZE * sizeof(T)));
+		this->mark_dirty(chunk);
+		return fs.good();
+	}
+
+	uint32 nb_mapped_chunks() const override
+	{
+		return nb_mapped_chunks_;
 	}
 
 
@@ -210,6 +293,7 @@ public:
 	 */
 	void copy_element(uint32 dst, uint32 src) override
 	{
+		this->mark_dirty(dst / CHUNK_SIZE);
 		table_data_[dst / CHUNK_SIZE][dst % CHUNK_SIZE] = table_data_[src / CHUNK_SIZE][src % CHUNK_SIZE];
 	}
 
@@ -222,6 +306,7 @@ public:
 	void copy_external_element(uint32 dst, Inherit* cag_src, uint32 src) override
 	{
 		Self* ca = static_cast<Self*>(cag_src);
+		this->mark_dirty(dst / CHUNK_SIZE);
 		table_data_[dst / CHUNK_SIZE][dst % CHUNK_SIZE] = ca->table_data_[src / CHUNK_SIZE][src % CHUNK_SIZE];
 	}
 
@@ -232,6 +317,7 @@ public:
 	 */
 	void move_element(uint32 dst, uint32 src) override
 	{
+		this->mark_dirty(dst / CHUNK_SIZE);
 		table_data_[dst / CHUNK_SIZE][dst % CHUNK_SIZE] = std::move(table_data_[src / CHUNK_SIZE][src % CHUNK_SIZE]);
 	}
 
@@ -242,6 +328,8 @@ public:
 	 */
 	void swap_elements(uint32 idx1, uint32 idx2) override
 	{
+		this->mark_dirty(idx1 / CHUNK_SIZE);
+		this->mark_dirty(idx2 / CHUNK_SIZE);
 // small workaround to avoid difficulties with std::swap when _GLIBCXX_DEBUG is defined.
 #ifndef _GLIBCXX_DEBUG
 		std::swap(table_data_[idx1 / CHUNK_SIZE][idx1 % CHUNK_SIZE], table_data_[idx2 / CHUNK_SIZE][idx2 % CHUNK_SIZE] );
@@ -322,6 +410,7 @@ public:
 			nbc++;
 
 		this->set_nb_chunks(nbc);
+		this->mark_all_dirty();
 
 		// load data chunks except last
 		nbc--;
@@ -365,6 +454,7 @@ public:
 	inline T& operator[](uint32 i)
 	{
 		cgogn_assert(i / CHUNK_SIZE < table_data_.size());
+		this->mark_dirty(i / CHUNK_SIZE);
 		return table_data_[i / CHUNK_SIZE][i % CHUNK_SIZE];
 	}
 
@@ -387,11 +477,13 @@ public:
 	inline void set_value(uint32 i, const T& v)
 	{
 		cgogn_assert(i / CHUNK_SIZE < table_data_.size());
+		this->mark_dirty(i / CHUNK_SIZE);
 		table_data_[i / CHUNK_SIZE][i % CHUNK_SIZE] = v;
 	}
 
 	inline void set_all_values(const T& v)
 	{
+		this->mark_all_dirty();
 		for (T* chunk : table_data_)
 		{
 			for(uint32 i = 0; i < CHUNK_SIZE; ++i)
@@ -427,6 +519,7 @@ public:
 		}
 
 		cgogn_message_assert(ca->nb_chunks()==this->nb_chunks(), "copy_data only with same sized ChunkArray");
+		this->mark_all_dirty();
 
 		auto td = table_data_.begin();
 		for (T* chunk : ca->table_data_)
@@ -746,6 +839,22 @@ public:
 			set_false(i);
 	}
 
+	/**
+	 * @brief thread safe version of set_value: the other bits of the word of i can be written at the same time
+	 * by other threads (@see ChunkArrayContainer::begin_concurrent_insertions)
+	 */
+	inline void set_value_concurrent(uint32 i, bool b)
+	{
+		static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "set_value_concurrent: atomic words are not lock-free");
+		cgogn_assert(i / CHUNK_SIZE < table_data_.size());
+		std::atomic<uint32>* word = reinterpret_cast<std::atomic<uint32>*>(&table_data_[i / CHUNK_SIZE][(i % CHUNK_SIZE) / BOOLS_PER_INT]);
+		const uint32 bit = 1u << ((i % CHUNK_SIZE) % BOOLS_PER_INT);
+		if (b)
+			word->fetch_or(bit, std::memory_order_relaxed);
+		else
+			word->fetch_and(~bit, std::memory_order_relaxed);
+	}
+
 	/**
 	 * @brief special optimized version of setFalse when goal is to set all to false;
 	 * @param i index of element to set to false
@@ -825,6 +934,83 @@ public:
 
 };
 
+/**
+ * @brief chunk array of epoch stamps (used by the epoch markers)
+ * An element is marked when its stamp is equal to the current epoch of the array. Unmarking all
+ * the elements only increments the epoch: the stamps are reset only when the epoch wraps around.
+ * New chunks are zero-initialized (0 is never a valid epoch).
+ */
+template <uint32 CHUNK_SIZE>
+class ChunkArrayStamp : public ChunkArray<CHUNK_SIZE, uint16>
+{
+public:
+
+	using Inherit = ChunkArray<CHUNK_SIZE, uint16>;
+	using Self = ChunkArrayStamp<CHUNK_SIZE>;
+
+protected:
+
+	uint16 epoch_;
+
+public:
+
+	inline ChunkArrayStamp() : Inherit(),
+		epoch_(1u)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ChunkArrayStamp);
+
+	inline uint16 epoch() const
+	{
+		return epoch_;
+	}
+
+	inline void mark(uint32 i)
+	{
+		cgogn_assert(i / CHUNK_SIZE < this->table_data_.size());
+		this->table_data_[i / CHUNK_SIZE][i % CHUNK_SIZE] = epoch_;
+	}
+
+	inline void unmark(uint32 i)
+	{
+		cgogn_assert(i / CHUNK_SIZE < this->table_data_.size());
+		this->table_data_[i / CHUNK_SIZE][i % CHUNK_SIZE] = 0u;
+	}
+
+	inline bool is_marked(uint32 i) const
+	{
+		cgogn_assert(i / CHUNK_SIZE < this->table_data_.size());
+		return this->table_data_[i / CHUNK_SIZE][i % CHUNK_SIZE] == epoch_;
+	}
+
+	/**
+	 * @brief unmark all the elements by starting a new epoch (O(1) except on wrap-around)
+	 */
+	inline void unmark_all()
+	{
+		if (++epoch_ == 0u)
+		{
+			for (uint16* const ptr : this->table_data_)
+				std::fill(ptr, ptr + CHUNK_SIZE, uint16(0u));
+			epoch_ = 1u;
+		}
+	}
+
+	inline uint32 count_marked() const
+	{
+		uint32 nb = 0u;
+		for (const uint16* ptr : this->table_data_)
+			nb += uint32(std::count(ptr, ptr + CHUNK_SIZE, epoch_));
+		return nb;
+	}
+
+	void clear() override
+	{
+		Inherit::clear();
+		epoch_ = 1u;
+	}
+};
+
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_CONTAINER_CHUNK_ARRAY_CPP_))
 //extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, bool>;
 extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, uint32>;
@@ -832,6 +1018,8 @@ extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, uint8>;
 extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, std::array<float32, 3>>;
 extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, std::array<float64, 3>>;
 extern template class CGOGN_CORE_API ChunkArrayBool<CGOGN_CHUNK_SIZE>;
+extern template class CGOGN_CORE_API ChunkArray<CGOGN_CHUNK_SIZE, uint16>;
+extern template class CGOGN_CORE_API ChunkArrayStamp<CGOGN_CHUNK_SIZE>;
 #endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_CONTAINER_CHUNK_ARRAY_CPP_))
 
 } // namespace cgogn
@@ -31,6 +31,9 @@
 #include <string>
 #include <memory>
 #include <climits>
+#include <atomic>
+#include <array>
+#include <algorithm>
 
 #include <cgogn/core/utils/logger.h>
 #include <cgogn/core/dll.h>
@@ -38,10 +41,13 @@
 #include <cgogn/core/utils/assert.h>
 #include <cgogn/core/utils/name_types.h>
 #include <cgogn/core/utils/unique_ptr.h>
+#include <cgogn/core/utils/thread.h>
 #include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/buffers.h>
+#include <cgogn/core/utils/reduction.h>
 
 #include <cgogn/core/container/chunk_array.h>
+#include <cgogn/core/container/chunk_array_soa.h>
 #include <cgogn/core/container/chunk_stack.h>
 #include <cgogn/core/container/chunk_array_factory.h>
 
@@ -66,15 +72,33 @@ public:
 	template <class T>
 	using ChunkArray = cgogn::ChunkArray<CHUNK_SIZE, T>;
 	using ChunkArrayBool = cgogn::ChunkArrayBool<CHUNK_SIZE>;
+	using ChunkArrayStamp = cgogn::ChunkArrayStamp<CHUNK_SIZE>;
+	template <class T>
+	using ChunkArraySoA = cgogn::ChunkArraySoA<CHUNK_SIZE, T>;
 	template <class T>
 	using ChunkStack = cgogn::ChunkStack<CHUNK_SIZE, T>;
 	using ChunkArrayFactory = cgogn::ChunkArrayFactory<CHUNK_SIZE>;
 
+	/**
+	 * bitmask of the used lines of a chunk (bit i%64 of word i/64 is set if the i-th line of the chunk is used)
+	 */
+	using ChunkMask = std::array<uint64, (CHUNK_SIZE + 63u) / 64u>;
+
 	/**
 	* constante d'attribut inconnu
 	*/
 	static const uint32 UNKNOWN = UINT32_MAX;
 
+	/**
+	 * version of the layout written by save_mapped
+	 */
+	static const uint32 MAPPED_LAYOUT_VERSION = 1u;
+
+	/**
+	 * version of the layout written by save_delta
+	 */
+	static const uint32 DELTA_LAYOUT_VERSION = 1u;
+
 protected:
 
 	/**
@@ -91,6 +115,11 @@ protected:
 	*/
 	std::vector<ChunkArrayBool*> table_marker_arrays_;
 
+	/**
+	* vector of pointers to epoch stamp ChunkArray (used by epoch markers)
+	*/
+	std::vector<ChunkArrayStamp*> table_stamp_arrays_;
+
 	/**
 	 * @brief ChunkArray of refs
 	 */
@@ -101,6 +130,48 @@ protected:
 	 */
 	ChunkStack<uint32> holes_stack_;
 
+	/**
+	 * allocator of the chunks of the (non marker) arrays
+	 */
+	ChunkAllocator chunk_allocator_;
+
+	/**
+	 * tracking of the modified chunks of the (non marker) arrays and refs (@see save_delta)
+	 */
+	bool dirty_tracking_;
+
+	/**
+	 * lines owned by a thread in concurrent insertion mode (@see begin_concurrent_insertions)
+	 */
+	struct LineReservation
+	{
+		uint32 next; // first fresh line of the block
+		uint32 end; // end of the block
+		int32 nb_used; // nb of lines inserted - nb of lines removed by the thread
+		std::vector<uint32> holes; // lines removed by the thread
+		std::vector<uint32> refs; // lines referenced by the thread (applied by end_concurrent_insertions)
+		std::vector<uint32> unrefs; // lines unreferenced by the thread (applied by end_concurrent_insertions)
+		char padding_[CACHE_LINE_SIZE];
+	};
+
+	/**
+	 * number of fresh lines grabbed at once by a thread (times PRIM_SIZE)
+	 */
+	static const uint32 CONCURRENT_BLOCK_SIZE = 64u;
+
+	/**
+	 * number of holes kept by a thread before giving the older ones to the others
+	 */
+	static const uint32 CONCURRENT_HOLES_BATCH = 64u;
+
+	bool concurrent_mode_;
+	std::vector<LineReservation> reservations_;
+	std::atomic<uint32> concurrent_max_lines_;
+	uint32 concurrent_capacity_;
+	// lock-free stack of holes shared by the threads: head = (tag << 32) | index, links indexed by line
+	std::atomic<uint64> concurrent_holes_head_;
+	std::unique_ptr<std::atomic<uint32>[]> concurrent_holes_next_;
+
 	/**
 	* size (number of elts) of the container
 	*/
@@ -172,6 +243,11 @@ public:
 	 * @brief ChunkArrayContainer constructor
 	 */
 	ChunkArrayContainer() :
+		dirty_tracking_(false),
+		concurrent_mode_(false),
+		concurrent_max_lines_(0u),
+		concurrent_capacity_(0u),
+		concurrent_holes_head_(UNKNOWN),
 		nb_used_lines_(0u),
 		nb_max_lines_(0u)
 	{
@@ -179,6 +255,7 @@ public:
 		names_.reserve(16);
 		type_names_.reserve(16);
 		table_marker_arrays_.reserve(16);
+		table_stamp_arrays_.reserve(16);
 	}
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ChunkArrayContainer);
@@ -193,6 +270,9 @@ public:
 
 		for (auto ptr : table_marker_arrays_)
 			delete ptr;
+
+		for (auto ptr : table_stamp_arrays_)
+			delete ptr;
 	}
 
 	inline const std::vector<std::string>& names() const
@@ -210,6 +290,32 @@ public:
 		return array_index(array_name) != UNKNOWN;
 	}
 
+	inline const ChunkAllocator& chunk_allocator() const
+	{
+		return chunk_allocator_;
+	}
+
+	/**
+	 * @brief set the allocator of the chunks of the arrays of the container (existing and future ones)
+	 * The marker arrays keep the default allocation and the refs are always value-initialized
+	 * (the lines of a new chunk must be seen as unused).
+	 * @param allocator the allocator
+	 * @return false if the container has chunks (the allocator is then unchanged)
+	 */
+	bool set_chunk_allocator(const ChunkAllocator& allocator)
+	{
+		if (refs_.nb_chunks() != 0u)
+		{
+			cgogn_log_warning("ChunkArrayContainer::set_chunk_allocator") << "Cannot change the allocator of a non empty container.";
+			return false;
+		}
+		chunk_allocator_ = allocator;
+		refs_.set_chunk_allocator(ChunkAllocator(allocator.mode(), true));
+		for (auto cagen : table_arrays_)
+			cagen->set_chunk_allocator(allocator);
+		return true;
+	}
+
 	/**
 	 * @brief get a chunk array
 	 * @param name name of attribute
@@ -232,6 +338,21 @@ public:
 		return const_cast<const ChunkArray<T>*>(const_cast<Self*>(this)->get_chunk_array<T>(name));
 	}
 
+	/**
+	 * @brief get a chunk array stored with a structure of arrays layout
+	 * @param name name of attribute
+	 * @tparam T type of attribute
+	 * @return pointer on attribute ChunkArraySoA (nullptr if it does not exist or is not a ChunkArraySoA<T>)
+	 */
+	template <typename T>
+	ChunkArraySoA<T>* get_chunk_array_soa(const std::string& name)
+	{
+		const uint32 index = array_index(name);
+		if (index == UNKNOWN)
+			return nullptr;
+		return dynamic_cast<ChunkArraySoA<T>*>(table_arrays_[index]);
+	}
+
 	ChunkArrayGen* get_chunk_array(const std::string& name)
 	{
 		// first check if attribute already exists
@@ -274,6 +395,28 @@ public:
 		return table_marker_arrays_;
 	}
 
+	inline const std::vector<ChunkArrayStamp*>& stamp_arrays()
+	{
+		return table_stamp_arrays_;
+	}
+
+	/**
+	 * @brief enable or disable the tracking of the modified chunks of the arrays (existing and future ones) and of the refs
+	 * (Re)enabling the tracking clears the modification flags: the next save_delta only writes what is modified from now.
+	 */
+	void set_dirty_tracking(bool b)
+	{
+		dirty_tracking_ = b;
+		refs_.set_dirty_tracking(b);
+		for (auto cagen : table_arrays_)
+			cagen->set_dirty_tracking(b);
+	}
+
+	inline bool dirty_tracking() const
+	{
+		return dirty_tracking_;
+	}
+
 	/**
 	 * @brief add an attribute
 	 * @param name name of chunk array
@@ -299,6 +442,8 @@ public:
 		chunk_array_factory<CHUNK_SIZE>().template register_CA<T>();
 
 		// reserve memory
+		carr->set_chunk_allocator(chunk_allocator_);
+		carr->set_dirty_tracking(dirty_tracking_);
 		carr->set_nb_chunks(refs_.nb_chunks());
 
 		// store pointer, name & typename.
@@ -309,6 +454,41 @@ public:
 		return carr;
 	}
 
+	/**
+	 * @brief add an attribute stored with a structure of arrays layout
+	 * Each component of the elements is stored in its own chunk (@see ChunkArraySoA).
+	 * The array is saved with the layout of a ChunkArray<T> and reloaded as such.
+	 * @param name name of chunk array
+	 * @tparam T type of chunk array data (must satisfy soa_traits<T>::value)
+	 * @return pointer on created ChunkArraySoA
+	 */
+	template <typename T>
+	ChunkArraySoA<T>* add_chunk_array_soa(const std::string& name)
+	{
+		cgogn_assert(name.size() != 0);
+
+		const uint32 index = array_index(name);
+		if (index != UNKNOWN)
+		{
+			cgogn_log_warning("add_chunk_array_soa") << "Chunk array of name \"" << name << "\" already exists.";
+			return nullptr;
+		}
+
+		std::string type_name = name_of_type(T());
+		ChunkArraySoA<T>* carr = new ChunkArraySoA<T>(name);
+		chunk_array_factory<CHUNK_SIZE>().template register_CA<T>();
+
+		carr->set_chunk_allocator(chunk_allocator_);
+		carr->set_dirty_tracking(dirty_tracking_);
+		carr->set_nb_chunks(refs_.nb_chunks());
+
+		table_arrays_.push_back(carr);
+		names_.push_back(name);
+		type_names_.push_back(std::move(type_name));
+
+		return carr;
+	}
+
 	/**
 	 * @brief remove a chunk array by its name
 	 * @param name name of chunk array to remove
@@ -420,25 +600,36 @@ public:
 		return mca;
 	}
 
-//	/**
-//	 * @brief remove a marker attribute by its ChunkArray pointer
-//	 * @param ptr ChunkArray pointer to the attribute to remove
-//	 * @return true if attribute exists and has been removed
-//	 */
-//	void remove_marker_attribute(const ChunkArrayBool* ptr)
-//	{
-//		uint32 index = 0u;
-//		while (index < table_marker_arrays_.size() && table_marker_arrays_[index] != ptr)
-//			++index;
+	/**
+	 * @brief add an epoch stamp attribute
+	 * @return pointer on created ChunkArray
+	 */
+	ChunkArrayStamp* add_stamp_attribute()
+	{
+		ChunkArrayStamp* sca = new ChunkArrayStamp();
+		sca->set_nb_chunks(refs_.nb_chunks());
+		table_stamp_arrays_.push_back(sca);
+		return sca;
+	}
 
-//		cgogn_message_assert(index != table_marker_arrays_.size(), "remove_marker_attribute by ptr: attribute not found.");
+	/**
+	 * @brief remove a marker attribute by its ChunkArray pointer
+	 * @param ptr ChunkArray pointer to the attribute to remove
+	 */
+	void remove_marker_attribute(const ChunkArrayBool* ptr)
+	{
+		uint32 index = 0u;
+		while (index < table_marker_arrays_.size() && table_marker_arrays_[index] != ptr)
+			++index;
 
-//		if (index != table_marker_arrays_.size() - std::size_t(1u))
-//			table_marker_arrays_[index] = table_marker_arrays_.back();
-//		table_marker_arrays_.pop_back();
+		cgogn_message_assert(index != table_marker_arrays_.size(), "remove_marker_attribute by ptr: attribute not found.");
 
-//		delete ptr;
-//	}
+		if (index != table_marker_arrays_.size() - std::size_t(1u))
+			table_marker_arrays_[index] = table_marker_arrays_.back();
+		table_marker_arrays_.pop_back();
+
+		delete ptr;
+	}
 
 	/**
 	 * @brief Number of chunk arrays of the container
@@ -565,6 +756,8 @@ public:
 			 cagen->clear();
 		for (auto ca_bool : table_marker_arrays_)
 			ca_bool->clear();
+		for (auto ca_stamp : table_stamp_arrays_)
+			ca_stamp->clear();
 	}
 
 	void remove_chunk_arrays()
@@ -596,8 +789,11 @@ public:
 		names_.swap(container.names_);
 		type_names_.swap(container.type_names_);
 		table_marker_arrays_.swap(container.table_marker_arrays_);
+		table_stamp_arrays_.swap(container.table_stamp_arrays_);
 		refs_.swap_data(&(container.refs_));
 		holes_stack_.swap_data(&(container.holes_stack_));
+		std::swap(chunk_allocator_, container.chunk_allocator_);
+		std::swap(dirty_tracking_, container.dirty_tracking_);
 		std::swap(nb_used_lines_, container.nb_used_lines_);
 		std::swap(nb_max_lines_, container.nb_max_lines_);
 		// invalidate existing external refs
@@ -605,10 +801,14 @@ public:
 			cagen->invalidate_external_refs();
 		for (auto cagen : table_marker_arrays_)
 			cagen->invalidate_external_refs();
+		for (auto cagen : table_stamp_arrays_)
+			cagen->invalidate_external_refs();
 		for (auto cagen : container.table_arrays_)
 			cagen->invalidate_external_refs();
 		for (auto cagen : container.table_marker_arrays_)
 			cagen->invalidate_external_refs();
+		for (auto cagen : container.table_stamp_arrays_)
+			cagen->invalidate_external_refs();
 	}
 
 	/**
@@ -661,11 +861,103 @@ public:
 		for (auto arr : table_marker_arrays_)
 			arr->set_nb_chunks(new_nb_blocks);
 
+		for (auto arr : table_stamp_arrays_)
+			arr->set_nb_chunks(new_nb_blocks);
+
 		refs_.set_nb_chunks(new_nb_blocks);
 
 		return map_old_new;
 	}
 
+	/**
+	 * @brief reorder the lines of the container
+	 * The groups of PRIM_SIZE lines are moved so that the i-th group of order becomes the i-th group of the container
+	 * and the holes are removed (as by compact). The values of all the arrays, markers and refs are moved: the pointers
+	 * on the arrays stay valid, the indices of lines stored elsewhere (embeddings, darts) must be updated with the
+	 * returned mapping.
+	 * @param order first line of each used group, in the new order (size() / PRIM_SIZE lines)
+	 * @return map_old_new vector that contains a map from old indices to new indices (holes -> 0xffffffff),
+	 * empty if order is not a permutation of the used groups (the container is then unchanged)
+	 */
+	template <uint32 PRIM_SIZE>
+	std::vector<uint32> reorder(const std::vector<uint32>& order)
+	{
+		const uint32 nb_groups = nb_used_lines_ / PRIM_SIZE;
+		std::vector<uint32> map_old_new(nb_max_lines_, std::numeric_limits<uint32>::max());
+		if (order.size() != nb_groups)
+		{
+			cgogn_log_warning("ChunkArrayContainer::reorder") << "The order does not contain all the used lines.";
+			return std::vector<uint32>();
+		}
+		for (uint32 i = 0u; i < nb_groups; ++i)
+		{
+			const uint32 old = order[i];
+			if (old % PRIM_SIZE != 0u || old >= nb_max_lines_ || !used(old) || map_old_new[old] != std::numeric_limits<uint32>::max())
+			{
+				cgogn_log_warning("ChunkArrayContainer::reorder") << "The order is not a permutation of the used lines.";
+				return std::vector<uint32>();
+			}
+			for (uint32 k = 0u; k < PRIM_SIZE; ++k)
+				map_old_new[old + k] = i * PRIM_SIZE + k;
+		}
+
+		// source of each line, the holes are moved after the used lines
+		std::vector<uint32> new_old(nb_max_lines_);
+		uint32 next_hole = nb_used_lines_;
+		for (uint32 l = 0u; l < nb_max_lines_; ++l)
+		{
+			if (map_old_new[l] != std::numeric_limits<uint32>::max())
+				new_old[map_old_new[l]] = l;
+			else
+				new_old[next_hole++] = l;
+		}
+
+		// the permutation is applied cycle by cycle with the same sequence of swaps for all the arrays
+		std::vector<std::pair<uint32, uint32>> swaps;
+		swaps.reserve(nb_max_lines_);
+		std::vector<bool> done(nb_max_lines_, false);
+		for (uint32 l = 0u; l < nb_max_lines_; ++l)
+		{
+			if (done[l])
+				continue;
+			done[l] = true;
+			for (uint32 cur = l; new_old[cur] != l; cur = new_old[cur])
+			{
+				swaps.emplace_back(cur, new_old[cur]);
+				done[new_old[cur]] = true;
+			}
+		}
+		auto apply_swaps = [&swaps] (ChunkArrayGen* ca)
+		{
+			for (const auto& s : swaps)
+				ca->swap_elements(s.first, s.second);
+		};
+		for (auto arr : table_arrays_)
+			apply_swaps(arr);
+		for (auto arr : table_marker_arrays_)
+			apply_swaps(arr);
+		for (auto arr : table_stamp_arrays_)
+			apply_swaps(arr);
+		apply_swaps(&refs_);
+
+		holes_stack_.clear();
+		const uint32 old_nb_blocks = nb_max_lines_ / CHUNK_SIZE + 1u;
+		nb_max_lines_ = nb_used_lines_;
+		const uint32 new_nb_blocks = nb_max_lines_ / CHUNK_SIZE + 1u;
+		if (old_nb_blocks != new_nb_blocks)
+		{
+			for (auto arr : table_arrays_)
+				arr->set_nb_chunks(new_nb_blocks);
+			for (auto arr : table_marker_arrays_)
+				arr->set_nb_chunks(new_nb_blocks);
+			for (auto arr : table_stamp_arrays_)
+				arr->set_nb_chunks(new_nb_blocks);
+			refs_.set_nb_chunks(new_nb_blocks);
+		}
+
+		return map_old_new;
+	}
+
 	bool check_before_merge(const Self& cac)
 	{
 		for (uint32 i = 0; i < cac.names_.size(); ++i)
@@ -701,6 +993,8 @@ public:
 				map_attrib[i] = uint32(table_arrays_.size());
 				auto cag = chunk_array_factory<CHUNK_SIZE>().create(type_name,name);
 				cgogn_assert(cag);
+				cag->set_chunk_allocator(chunk_allocator_);
+				cag->set_dirty_tracking(dirty_tracking_);
 				cag->set_nb_chunks(refs_.nb_chunks());
 				table_arrays_.push_back(cag.release());
 				names_.push_back(name);
@@ -761,6 +1055,7 @@ public:
 	uint32 insert_lines()
 	{
 		static_assert(PRIM_SIZE < CHUNK_SIZE, "Cannot insert lines in a container if PRIM_SIZE < CHUNK_SIZE");
+		cgogn_message_assert(!concurrent_mode_, "insert_lines: use insert_lines_concurrent in concurrent insertion mode");
 
 		uint32 index;
 
@@ -772,10 +1067,13 @@ public:
 					arr->add_chunk();
 				for (auto arr : table_marker_arrays_)
 					arr->add_chunk();
+				for (auto arr : table_stamp_arrays_)
+					arr->add_chunk();
 				refs_.add_chunk();
 			}
 
-			if ((nb_max_lines_ + PRIM_SIZE) % CHUNK_SIZE < PRIM_SIZE) // prim does not fit on current chunk? -> add chunk
+			// prim does not fit on current chunk (and the next chunk is not reserved)? -> add chunk
+			if ((nb_max_lines_ + PRIM_SIZE) % CHUNK_SIZE < PRIM_SIZE && refs_.nb_chunks() <= (nb_max_lines_ + PRIM_SIZE) / CHUNK_SIZE)
 			{
 				// nb_max_lines_ = refs_.nb_chunks() * CHUNK_SIZE; // next index will be at start of new chunk
 
@@ -783,6 +1081,8 @@ public:
 					arr->add_chunk();
 				for (auto arr : table_marker_arrays_)
 					arr->add_chunk();
+				for (auto arr : table_stamp_arrays_)
+					arr->add_chunk();
 				refs_.add_chunk();
 			}
 
@@ -804,6 +1104,29 @@ public:
 		return index;
 	}
 
+	/**
+	 * @brief allocate at once the chunks needed by nb_lines new lines inserted at the end of the container
+	 * The following insertions do not add chunks until the reserved lines are used (@see insert_lines).
+	 * @param nb_lines number of lines that will be inserted
+	 */
+	void reserve(uint32 nb_lines)
+	{
+		cgogn_message_assert(!concurrent_mode_, "reserve: not allowed in concurrent insertion mode");
+
+		// same number of chunks as after sequential insertions (@see insert_lines)
+		const uint32 nb_chunks = (nb_max_lines_ + nb_lines) / CHUNK_SIZE + 1u;
+		if (nb_chunks <= refs_.nb_chunks())
+			return;
+
+		for (auto arr : table_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		for (auto arr : table_marker_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		for (auto arr : table_stamp_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		refs_.set_nb_chunks(nb_chunks);
+	}
+
 	/**
 	* @brief remove a group of PRIM_SIZE lines in the container
 	* @param index index of one line of group to remove
@@ -814,6 +1137,7 @@ public:
 		uint32 begin_prim_idx = (index / PRIM_SIZE) * PRIM_SIZE;
 
 		cgogn_message_assert(used(begin_prim_idx), "Error removing non existing index");
+		cgogn_message_assert(!concurrent_mode_, "remove_lines: use remove_lines_concurrent in concurrent insertion mode");
 
 		holes_stack_.push(begin_prim_idx);
 
@@ -824,6 +1148,199 @@ public:
 		nb_used_lines_ -= PRIM_SIZE;
 	}
 
+	/**
+	 * @brief enter the concurrent insertion mode
+	 * The chunks needed by nb_lines new lines are allocated at once and the holes are moved to a lock-free stack.
+	 * Until end_concurrent_insertions, the lines are inserted and removed with insert_lines_concurrent and
+	 * remove_lines_concurrent, which can be called by several threads (main thread and workers of the thread pools)
+	 * at the same time. Each thread takes the fresh lines by blocks and keeps the lines it removes to reuse them.
+	 * The reference counters updates (ref_line, unref_line) are deferred until end_concurrent_insertions.
+	 * The arrays must not be added/removed and size() is not updated during the concurrent insertion mode.
+	 * @param nb_lines maximum number of lines that will be inserted at the end of the container (multiple of PRIM_SIZE)
+	 */
+	template <uint32 PRIM_SIZE>
+	void begin_concurrent_insertions(uint32 nb_lines)
+	{
+		cgogn_message_assert(!concurrent_mode_, "begin_concurrent_insertions: already in concurrent insertion mode");
+		cgogn_message_assert(nb_lines % PRIM_SIZE == 0u, "begin_concurrent_insertions: nb_lines must be a multiple of PRIM_SIZE");
+
+		concurrent_capacity_ = nb_max_lines_ + nb_lines;
+		concurrent_max_lines_ = nb_max_lines_;
+
+		// same number of chunks as after sequential insertions (@see insert_lines)
+		const uint32 nb_chunks = std::max(refs_.nb_chunks(), concurrent_capacity_ / CHUNK_SIZE + 1u);
+		for (auto arr : table_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		for (auto arr : table_marker_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		for (auto arr : table_stamp_arrays_)
+			arr->set_nb_chunks(nb_chunks);
+		refs_.set_nb_chunks(nb_chunks);
+
+		concurrent_holes_next_.reset(new std::atomic<uint32>[concurrent_capacity_]);
+		concurrent_holes_head_ = UNKNOWN;
+		while (!holes_stack_.empty())
+		{
+			push_concurrent_hole(holes_stack_.head());
+			holes_stack_.pop();
+		}
+
+		const uint32 nb_threads = thread_pool()->max_nb_workers() + external_thread_pool()->max_nb_workers() + 1u; // +1 for main thread
+		reservations_.clear();
+		reservations_.resize(nb_threads);
+		for (LineReservation& r : reservations_)
+		{
+			r.next = 0u;
+			r.end = 0u;
+			r.nb_used = 0;
+		}
+
+		concurrent_mode_ = true;
+	}
+
+	/**
+	 * @brief leave the concurrent insertion mode
+	 * The holes of all the threads and the unused fresh lines of their blocks are pushed on the holes stack,
+	 * then the deferred references are applied: all the refs before the unrefs, so that a line is only removed
+	 * if it is not referenced at the end.
+	 */
+	template <uint32 PRIM_SIZE>
+	void end_concurrent_insertions()
+	{
+		cgogn_message_assert(concurrent_mode_, "end_concurrent_insertions: not in concurrent insertion mode");
+
+		nb_max_lines_ = std::min(concurrent_max_lines_.load(), concurrent_capacity_);
+		uint32 hole;
+		while (pop_concurrent_hole(hole))
+			holes_stack_.push(hole);
+		for (LineReservation& r : reservations_)
+		{
+			for (uint32 l = r.next; l + PRIM_SIZE <= r.end; l += PRIM_SIZE)
+				holes_stack_.push(l);
+			for (uint32 h : r.holes)
+				holes_stack_.push(h);
+			nb_used_lines_ = uint32(int32(nb_used_lines_) + r.nb_used);
+		}
+		concurrent_mode_ = false;
+
+		for (const LineReservation& r : reservations_)
+			for (uint32 l : r.refs)
+				ref_line(l);
+		for (const LineReservation& r : reservations_)
+			for (uint32 l : r.unrefs)
+				unref_line(l);
+
+		reservations_.clear();
+		reservations_.shrink_to_fit();
+		concurrent_holes_next_.reset();
+	}
+
+	inline bool concurrent_mode() const
+	{
+		return concurrent_mode_;
+	}
+
+	/**
+	 * @brief insert a group of PRIM_SIZE consecutive lines in the container (thread safe, concurrent insertion mode only)
+	 * @return index of the first line of group or UNKNOWN if the lines reserved by begin_concurrent_insertions are exhausted
+	 */
+	template <uint32 PRIM_SIZE>
+	uint32 insert_lines_concurrent()
+	{
+		static_assert(PRIM_SIZE < CHUNK_SIZE, "Cannot insert lines in a container if PRIM_SIZE < CHUNK_SIZE");
+		cgogn_message_assert(concurrent_mode_, "insert_lines_concurrent: not in concurrent insertion mode");
+		cgogn_assert(current_thread_marker_index() < reservations_.size());
+
+		LineReservation& r = reservations_[current_thread_marker_index()];
+		uint32 index;
+		if (!r.holes.empty())
+		{
+			index = r.holes.back();
+			r.holes.pop_back();
+		}
+		else if (!pop_concurrent_hole(index))
+		{
+			if (r.next + PRIM_SIZE > r.end)
+			{
+				const uint32 block = concurrent_max_lines_.fetch_add(CONCURRENT_BLOCK_SIZE * PRIM_SIZE, std::memory_order_relaxed);
+				if (block >= concurrent_capacity_)
+					return UNKNOWN;
+				r.next = block;
+				r.end = std::min(block + CONCURRENT_BLOCK_SIZE * PRIM_SIZE, concurrent_capacity_);
+			}
+			index = r.next;
+			r.next += PRIM_SIZE;
+		}
+
+		for (uint32 i = 0u; i < PRIM_SIZE; ++i)
+			refs_.set_value(index + i, 1u);
+		r.nb_used += int32(PRIM_SIZE);
+
+		return index;
+	}
+
+	/**
+	 * @brief remove a group of PRIM_SIZE lines in the container (thread safe, concurrent insertion mode only)
+	 * The lines of a group must not be removed by two threads.
+	 * @param index index of one line of group to remove
+	 */
+	template <uint32 PRIM_SIZE>
+	void remove_lines_concurrent(uint32 index)
+	{
+		cgogn_message_assert(concurrent_mode_, "remove_lines_concurrent: not in concurrent insertion mode");
+		cgogn_assert(current_thread_marker_index() < reservations_.size());
+
+		uint32 begin_prim_idx = (index / PRIM_SIZE) * PRIM_SIZE;
+		cgogn_message_assert(used(begin_prim_idx), "Error removing non existing index");
+
+		for (uint32 i = 0u; i < PRIM_SIZE; ++i)
+			refs_.set_value(begin_prim_idx + i, 0u);
+
+		LineReservation& r = reservations_[current_thread_marker_index()];
+		r.nb_used -= int32(PRIM_SIZE);
+		r.holes.push_back(begin_prim_idx);
+		// share the older holes with the other threads
+		if (r.holes.size() >= 2u * CONCURRENT_HOLES_BATCH)
+		{
+			for (uint32 i = 0u; i < CONCURRENT_HOLES_BATCH; ++i)
+				push_concurrent_hole(r.holes[i]);
+			r.holes.erase(r.holes.begin(), r.holes.begin() + CONCURRENT_HOLES_BATCH);
+		}
+	}
+
+protected:
+
+	/**
+	 * the tag of the head is incremented by each operation to prevent the ABA problem
+	 */
+	void push_concurrent_hole(uint32 index)
+	{
+		uint64 head = concurrent_holes_head_.load(std::memory_order_relaxed);
+		uint64 new_head;
+		do
+		{
+			concurrent_holes_next_[index].store(uint32(head), std::memory_order_relaxed);
+			new_head = (((head >> 32u) + 1u) << 32u) | index;
+		} while (!concurrent_holes_head_.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	bool pop_concurrent_hole(uint32& index)
+	{
+		uint64 head = concurrent_holes_head_.load(std::memory_order_acquire);
+		for (;;)
+		{
+			index = uint32(head);
+			if (index == UNKNOWN)
+				return false;
+			const uint32 next = concurrent_holes_next_[index].load(std::memory_order_relaxed);
+			const uint64 new_head = (((head >> 32u) + 1u) << 32u) | next;
+			if (concurrent_holes_head_.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+				return true;
+		}
+	}
+
+public:
+
 
 	/**
 	 * @brief initialize the markers of a line of the container
@@ -833,8 +1350,19 @@ public:
 	{
 		cgogn_message_assert(used(index), "init_markers_of_line only with allocated lines");
 
-		for (auto ptr : table_marker_arrays_)
-			ptr->set_false(index);
+		if (concurrent_mode_)
+		{
+			for (auto ptr : table_marker_arrays_)
+				ptr->set_value_concurrent(index, false);
+		}
+		else
+		{
+			for (auto ptr : table_marker_arrays_)
+				ptr->set_false(index);
+		}
+
+		for (auto ptr : table_stamp_arrays_)
+			ptr->unmark(index);
 	}
 
 	/**
@@ -853,6 +1381,8 @@ public:
 		{
 			for (auto ptr : table_marker_arrays_)
 				ptr->copy_element(dst, src);
+			for (auto ptr : table_stamp_arrays_)
+				ptr->copy_element(dst, src);
 		}
 		if (copy_refs)
 			refs_[dst] = refs_[src];
@@ -876,6 +1406,8 @@ public:
 		{
 			for (auto ptr : table_marker_arrays_)
 				ptr->copy_element(dst, src);
+			for (auto ptr : table_stamp_arrays_)
+				ptr->copy_element(dst, src);
 		}
 		if (copy_refs)
 			refs_[dst] = refs_[src];
@@ -884,21 +1416,32 @@ public:
 	/**
 	* @brief increment the reference counter of the given line (only for PRIM_SIZE==1)
 	* @param index index of the line
+	* In concurrent insertion mode, the update is deferred until end_concurrent_insertions.
 	*/
 	void ref_line(uint32 index)
 	{
 		// static_assert(PRIM_SIZE == 1u, "refLine with container where PRIM_SIZE!=1");
+		if (concurrent_mode_)
+		{
+			reservations_[current_thread_marker_index()].refs.push_back(index);
+			return;
+		}
 		refs_[index]++;
 	}
 
 	/**
 	* @brief decrement the reference counter of the given line (only for PRIM_SIZE==1)
 	* @param index index of the line
-	* @return true if the line was removed
+	* @return true if the line was removed (always false in concurrent insertion mode, the update is deferred)
 	*/
 	bool unref_line(uint32 index)
 	{
 		// static_assert(PRIM_SIZE == 1u, "unrefLine with container where PRIM_SIZE!=1");
+		if (concurrent_mode_)
+		{
+			reservations_[current_thread_marker_index()].unrefs.push_back(index);
+			return false;
+		}
 		cgogn_message_assert(refs_[index] > 1u, "Container: unref line with nb_ref == 1");
 
 		refs_[index]--;
@@ -939,6 +1482,9 @@ public:
 
 		for (auto* cab : table_marker_arrays_)
 			cab->set_nb_chunks(refs_.nb_chunks());
+
+		for (auto* cas : table_stamp_arrays_)
+			cas->set_nb_chunks(refs_.nb_chunks());
 	}
 
 
@@ -1023,6 +1569,8 @@ public:
 			auto cag = chunk_array_factory<CHUNK_SIZE>().create(type_names_[i], names_[i]);
 			if (cag)
 			{
+				cag->set_chunk_allocator(chunk_allocator_);
+				cag->set_dirty_tracking(dirty_tracking_);
 				table_arrays_.push_back(cag.release());
 				ok &= table_arrays_.back()->load(fs);
 				++i;
@@ -1040,6 +1588,424 @@ public:
 		return ok;
 	}
 
+	/**
+	 * @brief save the container with a layout that can be used in place from a mapped file (@see load_mapped)
+	 * The chunks of the mappable arrays and of the refs are written raw, the first one of each array
+	 * at an offset (from the beginning of the stream) multiple of alignment. The other arrays
+	 * (e.g. strings, vectors) are serialized as by save.
+	 * @param fs binary output stream
+	 * @param alignment alignment of the chunks in the stream (e.g. the page size)
+	 */
+	void save_mapped(std::ostream& fs, uint32 alignment) const
+	{
+		cgogn_assert(fs.good());
+
+		const uint32 header[5] = { MAPPED_LAYOUT_VERSION, uint32(table_arrays_.size()), nb_used_lines_, nb_max_lines_, refs_.nb_chunks() };
+		fs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		for (uint32 i = 0u; i < table_arrays_.size(); ++i)
+		{
+			write_mapped_string(fs, names_[i]);
+			write_mapped_string(fs, type_names_[i]);
+			save_mapped_array(fs, table_arrays_[i], alignment);
+		}
+		save_mapped_array(fs, &refs_, alignment);
+
+		// the holes are stored in [1, size] (@see ChunkStack::push)
+		const uint32 nb_holes = holes_stack_.size();
+		fs.write(reinterpret_cast<const char*>(&nb_holes), sizeof(uint32));
+		for (uint32 i = 1u; i <= nb_holes; ++i)
+			fs.write(reinterpret_cast<const char*>(&holes_stack_[i]), sizeof(uint32));
+	}
+
+	/**
+	 * @brief load a container saved by save_mapped
+	 * The chunks of the mappable arrays and of the refs point into the mapped file (no copy).
+	 * The existing arrays of the container are kept (and filled) when the stream contains an array
+	 * with the same name and type, which keeps valid the pointers on these arrays.
+	 * @param fs binary input stream on the mapped file, positioned at the beginning of the container
+	 * @param file mapped file
+	 * @param alignment alignment used by save_mapped
+	 * @return false if the stream is not a valid container
+	 */
+	bool load_mapped(std::istream& fs, const std::shared_ptr<MappedFile>& file, uint32 alignment)
+	{
+		cgogn_assert(fs.good() && file && file->is_open());
+
+		chunk_array_factory<CHUNK_SIZE>().register_known_types();
+		clear_chunk_arrays();
+
+		uint32 header[5];
+		fs.read(reinterpret_cast<char*>(header), sizeof(header));
+		if (!fs.good() || header[0] != MAPPED_LAYOUT_VERSION)
+		{
+			cgogn_log_error("ChunkArrayContainer::load_mapped") << "Unknown layout version.";
+			return false;
+		}
+		nb_used_lines_ = header[2];
+		nb_max_lines_ = header[3];
+		const uint32 nb_chunks = header[4];
+
+		std::vector<bool> loaded(table_arrays_.size(), false);
+		bool ok = true;
+		for (uint32 i = 0u; i < header[1] && ok; ++i)
+		{
+			const std::string name = read_mapped_string(fs);
+			const std::string type_name = read_mapped_string(fs);
+			const std::streampos info_pos = fs.tellg();
+			uint32 mapped;
+			fs.read(reinterpret_cast<char*>(&mapped), sizeof(uint32));
+			fs.seekg(info_pos);
+
+			ChunkArrayGen* cag = nullptr;
+			uint32 index = array_index(name);
+			if (index != UNKNOWN && (type_names_[index] != type_name || (mapped == 1u && !table_arrays_[index]->is_mappable())))
+			{
+				cgogn_log_warning("ChunkArrayContainer::load_mapped") << "The existing chunk array \"" << name << "\" is replaced.";
+				remove_chunk_array(index);
+				// the last array takes the place of the removed one
+				loaded[index] = loaded.back();
+				loaded.pop_back();
+				index = UNKNOWN;
+			}
+			if (index == UNKNOWN)
+			{
+				auto ca = chunk_array_factory<CHUNK_SIZE>().create(type_name, name);
+				if (ca)
+				{
+					ca->set_chunk_allocator(chunk_allocator_);
+					ca->set_dirty_tracking(dirty_tracking_);
+					cag = ca.release();
+					table_arrays_.push_back(cag);
+					names_.push_back(name);
+					type_names_.push_back(type_name);
+					loaded.push_back(true);
+				}
+				else
+					cgogn_log_warning("ChunkArrayContainer::load_mapped") << "Could not load attribute \"" << name << "\" of type \"" << type_name << "\".";
+			}
+			else
+			{
+				cag = table_arrays_[index];
+				loaded[index] = true;
+			}
+			ok &= load_mapped_array(fs, cag, file, alignment, nb_chunks);
+		}
+		ok = ok && load_mapped_array(fs, &refs_, file, alignment, nb_chunks);
+
+		// arrays of the container that are not in the stream and markers
+		for (uint32 i = 0u; i < table_arrays_.size(); ++i)
+		{
+			if (!loaded[i])
+				table_arrays_[i]->set_nb_chunks(nb_chunks);
+		}
+		for (auto ca_bool : table_marker_arrays_)
+			ca_bool->set_nb_chunks(nb_chunks);
+		for (auto ca_stamp : table_stamp_arrays_)
+			ca_stamp->set_nb_chunks(nb_chunks);
+
+		uint32 nb_holes = 0u;
+		fs.read(reinterpret_cast<char*>(&nb_holes), sizeof(uint32));
+		for (uint32 i = 0u; i < nb_holes; ++i)
+		{
+			uint32 hole;
+			fs.read(reinterpret_cast<char*>(&hole), sizeof(uint32));
+			holes_stack_.push(hole);
+		}
+
+		ok &= fs.good();
+		if (!ok)
+			cgogn_log_error("ChunkArrayContainer::load_mapped") << "Corrupted or truncated file.";
+		return ok;
+	}
+
+	/**
+	 * @brief save the modifications of the container since the tracking was enabled or since the last save_delta
+	 * For each array, only the modified chunks are written raw (the non mappable arrays, e.g. strings, are
+	 * serialized as by save if one of their chunks is modified), followed by the modified chunks of the refs
+	 * and by the whole holes stack. The modification flags are cleared.
+	 * @param fs binary output stream
+	 * @pre the dirty tracking is enabled (@see set_dirty_tracking)
+	 */
+	void save_delta(std::ostream& fs)
+	{
+		cgogn_assert(fs.good());
+		cgogn_message_assert(dirty_tracking_, "save_delta: the dirty tracking is not enabled");
+
+		const uint32 header[5] = { DELTA_LAYOUT_VERSION, uint32(table_arrays_.size()), nb_used_lines_, nb_max_lines_, refs_.nb_chunks() };
+		fs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		for (uint32 i = 0u; i < table_arrays_.size(); ++i)
+		{
+			write_mapped_string(fs, names_[i]);
+			write_mapped_string(fs, type_names_[i]);
+			save_delta_array(fs, table_arrays_[i]);
+		}
+		save_delta_array(fs, &refs_);
+
+		const uint32 nb_holes = holes_stack_.size();
+		fs.write(reinterpret_cast<const char*>(&nb_holes), sizeof(uint32));
+		for (uint32 i = 1u; i <= nb_holes; ++i)
+			fs.write(reinterpret_cast<const char*>(&holes_stack_[i]), sizeof(uint32));
+
+		for (auto cagen : table_arrays_)
+			cagen->clear_dirty_chunks();
+		refs_.clear_dirty_chunks();
+	}
+
+	/**
+	 * @brief apply a delta written by save_delta
+	 * The container must be in the state of the saved one when the delta started (i.e. it was loaded from
+	 * the same full save and all the previous deltas were applied in order). The arrays that are not in
+	 * the delta are removed, the new ones are created.
+	 * @param fs binary input stream
+	 * @return false if the stream is not a valid delta
+	 */
+	bool apply_delta(std::istream& fs)
+	{
+		cgogn_assert(fs.good());
+
+		chunk_array_factory<CHUNK_SIZE>().register_known_types();
+
+		uint32 header[5];
+		fs.read(reinterpret_cast<char*>(header), sizeof(header));
+		if (!fs.good() || header[0] != DELTA_LAYOUT_VERSION)
+		{
+			cgogn_log_error("ChunkArrayContainer::apply_delta") << "Unknown layout version.";
+			return false;
+		}
+		nb_used_lines_ = header[2];
+		nb_max_lines_ = header[3];
+		const uint32 nb_chunks = header[4];
+
+		std::vector<bool> in_delta(table_arrays_.size(), false);
+		bool ok = true;
+		for (uint32 i = 0u; i < header[1] && ok; ++i)
+		{
+			const std::string name = read_mapped_string(fs);
+			const std::string type_name = read_mapped_string(fs);
+			uint32 index = array_index(name);
+			if (index != UNKNOWN && type_names_[index] != type_name)
+			{
+				remove_chunk_array(index);
+				in_delta[index] = in_delta.back();
+				in_delta.pop_back();
+				index = UNKNOWN;
+			}
+			ChunkArrayGen* cag = nullptr;
+			if (index == UNKNOWN)
+			{
+				auto ca = chunk_array_factory<CHUNK_SIZE>().create(type_name, name);
+				if (ca)
+				{
+					ca->set_chunk_allocator(chunk_allocator_);
+					ca->set_dirty_tracking(dirty_tracking_);
+					cag = ca.release();
+					table_arrays_.push_back(cag);
+					names_.push_back(name);
+					type_names_.push_back(type_name);
+					in_delta.push_back(true);
+				}
+				else
+					cgogn_log_warning("ChunkArrayContainer::apply_delta") << "Could not load attribute \"" << name << "\" of type \"" << type_name << "\".";
+			}
+			else
+			{
+				cag = table_arrays_[index];
+				in_delta[index] = true;
+			}
+			ok &= apply_delta_array(fs, cag, nb_chunks);
+		}
+		ok = ok && apply_delta_array(fs, &refs_, nb_chunks);
+
+		// arrays removed from the saved container
+		for (uint32 i = uint32(table_arrays_.size()); i-- > 0u;)
+		{
+			if (!in_delta[i])
+				remove_chunk_array(i);
+		}
+		for (auto ca_bool : table_marker_arrays_)
+			ca_bool->set_nb_chunks(nb_chunks);
+		for (auto ca_stamp : table_stamp_arrays_)
+			ca_stamp->set_nb_chunks(nb_chunks);
+
+		uint32 nb_holes = 0u;
+		fs.read(reinterpret_cast<char*>(&nb_holes), sizeof(uint32));
+		holes_stack_.clear();
+		for (uint32 i = 0u; i < nb_holes; ++i)
+		{
+			uint32 hole;
+			fs.read(reinterpret_cast<char*>(&hole), sizeof(uint32));
+			holes_stack_.push(hole);
+		}
+
+		for (auto cagen : table_arrays_)
+			cagen->clear_dirty_chunks();
+		refs_.clear_dirty_chunks();
+
+		ok &= fs.good();
+		if (!ok)
+			cgogn_log_error("ChunkArrayContainer::apply_delta") << "Corrupted or truncated delta.";
+		return ok;
+	}
+
+protected:
+
+	static void write_mapped_string(std::ostream& fs, const std::string& str)
+	{
+		const uint32 length = uint32(str.size());
+		fs.write(reinterpret_cast<const char*>(&length), sizeof(uint32));
+		fs.write(str.data(), std::streamsize(length));
+	}
+
+	static std::string read_mapped_string(std::istream& fs)
+	{
+		uint32 length = 0u;
+		fs.read(reinterpret_cast<char*>(&length), sizeof(uint32));
+		std::string str(length, ' ');
+		if (length > 0u)
+			fs.read(&str[0], std::streamsize(length));
+		return str;
+	}
+
+	static std::streamoff aligned_offset(std::streamoff offset, uint32 alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	void save_mapped_array(std::ostream& fs, const ChunkArrayGen* cag, uint32 alignment) const
+	{
+		const uint32 info[2] = { cag->is_mappable() ? 1u : 0u, cag->is_mappable() ? cag->element_size() : 0u };
+		fs.write(reinterpret_cast<const char*>(info), sizeof(info));
+		if (info[0] == 1u)
+		{
+			const std::streamoff pos = fs.tellp();
+			const std::vector<char> padding(std::size_t(aligned_offset(pos, alignment) - pos), 0);
+			fs.write(padding.data(), std::streamsize(padding.size()));
+			uint32 byte_chunk_size;
+			for (const void* chunk : cag->chunks_pointers(byte_chunk_size))
+				fs.write(static_cast<const char*>(chunk), byte_chunk_size);
+		}
+		else
+			cag->save(fs, nb_max_lines_);
+	}
+
+	void save_delta_array(std::ostream& fs, const ChunkArrayGen* cag) const
+	{
+		const uint32 nb_dirty = cag->nb_dirty_chunks();
+		if (cag->is_mappable())
+		{
+			const uint32 info[3] = { 1u, cag->element_size(), nb_dirty };
+			fs.write(reinterpret_cast<const char*>(info), sizeof(info));
+			for (uint32 c = 0u, nb = cag->nb_chunks(); c < nb; ++c)
+			{
+				if (cag->is_dirty(c))
+				{
+					fs.write(reinterpret_cast<const char*>(&c), sizeof(uint32));
+					cag->save_raw_chunk(fs, c);
+				}
+			}
+		}
+		else
+		{
+			const uint32 info[3] = { 0u, 0u, nb_dirty > 0u ? 1u : 0u };
+			fs.write(reinterpret_cast<const char*>(info), sizeof(info));
+			if (info[2] == 1u)
+				cag->save(fs, nb_max_lines_);
+		}
+	}
+
+	/**
+	 * @param cag the array to update (nullptr to skip the data)
+	 */
+	bool apply_delta_array(std::istream& fs, ChunkArrayGen* cag, uint32 nb_chunks)
+	{
+		uint32 info[3];
+		fs.read(reinterpret_cast<char*>(info), sizeof(info));
+		if (!fs.good())
+			return false;
+		if (cag != nullptr)
+			cag->set_nb_chunks(nb_chunks);
+
+		if (info[0] == 0u)
+		{
+			if (info[2] == 0u)
+				return true;
+			if (cag == nullptr)
+			{
+				ChunkArrayGen::skip(fs);
+				return fs.good();
+			}
+			const bool ok = cag->load(fs);
+			cag->set_nb_chunks(nb_chunks);
+			return ok;
+		}
+
+		if (cag != nullptr && (!cag->is_mappable() || cag->element_size() != info[1]))
+		{
+			cgogn_log_error("ChunkArrayContainer::apply_delta") << "Wrong element type for the chunk array \"" << cag->name() << "\".";
+			return false;
+		}
+		const std::streamoff byte_chunk_size = std::streamoff(info[1]) * CHUNK_SIZE;
+		for (uint32 i = 0u; i < info[2]; ++i)
+		{
+			uint32 c = 0u;
+			fs.read(reinterpret_cast<char*>(&c), sizeof(uint32));
+			if (!fs.good() || c >= nb_chunks)
+				return false;
+			if (cag == nullptr)
+				fs.seekg(byte_chunk_size, std::ios::cur);
+			else if (!cag->load_raw_chunk(fs, c))
+				return false;
+		}
+		return fs.good();
+	}
+
+	/**
+	 * @param cag the array to load (nullptr to skip the data)
+	 */
+	bool load_mapped_array(std::istream& fs, ChunkArrayGen* cag, const std::shared_ptr<MappedFile>& file, uint32 alignment, uint32 nb_chunks)
+	{
+		uint32 info[2];
+		fs.read(reinterpret_cast<char*>(info), sizeof(info));
+		if (!fs.good())
+			return false;
+
+		if (info[0] == 0u)
+		{
+			if (cag == nullptr)
+			{
+				ChunkArrayGen::skip(fs);
+				return fs.good();
+			}
+			const bool ok = cag->load(fs);
+			cag->set_nb_chunks(nb_chunks);
+			return ok;
+		}
+
+		const std::streamoff begin = aligned_offset(fs.tellg(), alignment);
+		const std::size_t byte_chunk_size = std::size_t(info[1]) * CHUNK_SIZE;
+		const std::size_t end = std::size_t(begin) + byte_chunk_size * nb_chunks;
+		if (end > file->size())
+			return false;
+		fs.seekg(std::streamoff(end));
+
+		if (cag == nullptr)
+			return true;
+		if (cag->element_size() != info[1])
+		{
+			cgogn_log_error("ChunkArrayContainer::load_mapped") << "Wrong element size for the chunk array \"" << cag->name() << "\".";
+			return false;
+		}
+
+		std::vector<char*> chunks(nb_chunks);
+		for (uint32 c = 0u; c < nb_chunks; ++c)
+			chunks[c] = file->data() + begin + std::streamoff(c * byte_chunk_size);
+		return cag->attach_mapped_chunks(chunks, file);
+	}
+
+public:
+
 	template <typename FUNC>
 	void foreach_index(const FUNC& f) const
 	{
@@ -1123,8 +2089,168 @@ public:
 		for (auto& b : indices_buffers[1u])
 			buffs->release_buffer(b);
 	}
+
+	/**
+	 * @brief parallel reduction over the used indices of the container
+	 * The index range is split in blocks of CHUNK_SIZE lines that are distributed among the workers.
+	 * Each block has its own (cache line padded) partial and the partials are combined with init
+	 * in block order, so that the result does not depend on the number of workers.
+	 * @param init initial value (first operand of the final combination)
+	 * @param map_fn function applied to each used index (uint32 -> T)
+	 * @param combine_fn associative combination function ((T, T) -> T)
+	 * @return the combination of init with the values of all used indices
+	 */
+	template <typename T, typename MapFunc, typename CombineFunc>
+	T parallel_reduce_index(const T& init, const MapFunc& map_fn, const CombineFunc& combine_fn) const
+	{
+		static_assert(is_ith_func_parameter_same<MapFunc,0,uint32>::value, "Wrong function first parameter type");
+
+		const uint32 last = end();
+		const uint32 nb_blocks = (last + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		ReductionPartials<T> partials(nb_blocks, init);
+
+		auto reduce_block = [&] (uint32 k)
+		{
+			for (uint32 i = k * CHUNK_SIZE, block_end = std::min(last, (k + 1u) * CHUNK_SIZE); i < block_end; ++i)
+			{
+				if (used(i))
+					partials.accumulate(k, map_fn(i), combine_fn);
+			}
+		};
+
+		ThreadPool* thread_pool = cgogn::thread_pool();
+		const uint32 nb_workers = std::min(thread_pool->nb_workers(), nb_blocks);
+		if (nb_workers == 0u)
+		{
+			for (uint32 k = 0u; k < nb_blocks; ++k)
+				reduce_block(k);
+		}
+		else
+		{
+			std::atomic<uint32> next_block(0u);
+			TaskGroup group;
+			for (uint32 w = 0u; w < nb_workers; ++w)
+			{
+				thread_pool->enqueue(group, [&] ()
+				{
+					for (uint32 k = next_block++; k < nb_blocks; k = next_block++)
+						reduce_block(k);
+				});
+			}
+			group.wait();
+		}
+
+		return partials.result(init, combine_fn);
+	}
+
+	/**
+	 * @brief get the number of chunks of the container
+	 */
+	inline uint32 nb_chunks() const
+	{
+		return refs_.nb_chunks();
+	}
+
+	/**
+	 * @brief compute the bitmask of the used lines of a chunk from the reference counters
+	 * @param chunk index of the chunk
+	 * @param mask filled with the used lines of the chunk
+	 * @return the number of used lines in the chunk
+	 */
+	uint32 chunk_mask(uint32 chunk, ChunkMask& mask) const
+	{
+		mask.fill(0u);
+		const uint32 first = chunk * CHUNK_SIZE;
+		if (first >= nb_max_lines_)
+			return 0u;
+
+		const T_REF* refs = refs_.chunk_data(chunk);
+		const uint32 nb_lines = std::min(CHUNK_SIZE, nb_max_lines_ - first);
+		uint32 nb_used = 0u;
+		for (uint32 i = 0u; i < nb_lines; ++i)
+		{
+			if (refs[i] != 0)
+			{
+				mask[i / 64u] |= uint64(1u) << (i % 64u);
+				++nb_used;
+			}
+		}
+		return nb_used;
+	}
+
+	/**
+	 * @brief apply a function on each chunk that contains used lines
+	 * The function receives the index of the chunk and the ChunkMask of its used lines,
+	 * and can process the whole chunk at once through the chunk_data of the attributes.
+	 * @param f function (uint32 chunk, const ChunkMask& mask)
+	 */
+	template <typename FUNC>
+	void foreach_chunk(const FUNC& f) const
+	{
+		static_assert(is_ith_func_parameter_same<FUNC,0,uint32>::value, "Wrong function first parameter type");
+		static_assert(is_ith_func_parameter_same<FUNC,1,const ChunkMask&>::value, "Wrong function second parameter type");
+
+		ChunkMask mask;
+		const uint32 nbc = (nb_max_lines_ + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		for (uint32 c = 0u; c < nbc; ++c)
+		{
+			if (chunk_mask(c, mask) > 0u)
+				f(c, mask);
+		}
+	}
+
+	/**
+	 * @brief apply a function in parallel on each chunk that contains used lines
+	 * The chunks are distributed among the workers, each chunk is processed by only one worker.
+	 * @param f function (uint32 chunk, const ChunkMask& mask)
+	 */
+	template <typename FUNC>
+	void parallel_foreach_chunk(const FUNC& f) const
+	{
+		static_assert(is_ith_func_parameter_same<FUNC,0,uint32>::value, "Wrong function first parameter type");
+		static_assert(is_ith_func_parameter_same<FUNC,1,const ChunkMask&>::value, "Wrong function second parameter type");
+
+		const uint32 nbc = (nb_max_lines_ + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		ThreadPool* thread_pool = cgogn::thread_pool();
+		const uint32 nb_workers = std::min(thread_pool->nb_workers(), nbc);
+		if (nb_workers == 0u)
+			return foreach_chunk(f);
+
+		std::atomic<uint32> next_chunk(0u);
+		TaskGroup group;
+		for (uint32 w = 0u; w < nb_workers; ++w)
+		{
+			thread_pool->enqueue(group, [&] ()
+			{
+				ChunkMask mask;
+				for (uint32 c = next_chunk++; c < nbc; c = next_chunk++)
+				{
+					if (chunk_mask(c, mask) > 0u)
+						f(c, mask);
+				}
+			});
+		}
+		group.wait();
+	}
 };
 
+/**
+ * @brief call f(i) for each line i of a chunk whose bit is set in the given ChunkMask
+ */
+template <typename MASK, typename FUNC>
+inline void foreach_chunk_line(const MASK& mask, const FUNC& f)
+{
+	for (uint32 w = 0u; w < uint32(mask.size()); ++w)
+	{
+		uint64 bits = mask[w];
+		for (uint32 i = 64u * w; bits != 0u; ++i, bits >>= 1u)
+		{
+			if ((bits & 1u) != 0u)
+				f(i);
+		}
+	}
+}
+
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_CORE_CONTAINER_CHUNK_ARRAY_CONTAINER_CPP_))
 extern template class CGOGN_CORE_API ChunkArrayContainer<CGOGN_CHUNK_SIZE, uint32>;
 extern template class CGOGN_CORE_API ChunkArrayContainer<CGOGN_CHUNK_SIZE, uint8>;
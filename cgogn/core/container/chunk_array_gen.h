@@ -25,6 +25,9 @@
 #define CGOGN_CORE_CONTAINER_CHUNK_ARRAY_GEN_H_
 
 #include <cgogn/core/utils/serialization.h>
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/utils/mapped_file.h>
+#include <cgogn/core/container/chunk_allocator.h>
 #include <cgogn/core/dll.h>
 
 #include <cgogn/core/cmap/map_traits.h>
@@ -33,6 +36,7 @@
 #include <iostream>
 #include <algorithm>
 #include <memory>
+#include <atomic>
 
 namespace cgogn
 {
@@ -53,10 +57,16 @@ public:
 
 	inline ChunkArrayGen(const std::string& name, const std::string& type_name) :
 		name_(name),
-		type_name_(type_name)
+		type_name_(type_name),
+		nb_dirty_flags_(0u),
+		dirty_flags_capacity_(0u),
+		dirty_tracking_(false)
 	{}
 
-	inline ChunkArrayGen()
+	inline ChunkArrayGen() :
+		nb_dirty_flags_(0u),
+		dirty_flags_capacity_(0u),
+		dirty_tracking_(false)
 	{}
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ChunkArrayGen);
@@ -69,6 +79,15 @@ protected:
 
 	std::string type_name_;
 
+	// allocator of the chunks of the array
+	ChunkAllocator allocator_;
+
+	// modification flags of the chunks (@see set_dirty_tracking)
+	std::unique_ptr<std::atomic<uint8>[]> dirty_chunks_;
+	uint32 nb_dirty_flags_;
+	uint32 dirty_flags_capacity_;
+	bool dirty_tracking_;
+
 public:
 
 	/**
@@ -110,6 +129,103 @@ public:
 
 	inline const std::string& type_name() const { return type_name_; }
 
+	inline const ChunkAllocator& chunk_allocator() const { return allocator_; }
+
+	/**
+	 * @brief enable or disable the tracking of the modified chunks
+	 * When enabled, a chunk is flagged as dirty when it is created and when its elements are accessed
+	 * through the non-const interface of the array (operator[], set_value, chunk_data, copy_element, ...).
+	 * (Re)enabling the tracking clears the flags.
+	 */
+	void set_dirty_tracking(bool b)
+	{
+		dirty_tracking_ = b;
+		nb_dirty_flags_ = 0u;
+		resize_dirty_flags(this->nb_chunks());
+		clear_dirty_chunks();
+	}
+
+	inline bool dirty_tracking() const { return dirty_tracking_; }
+
+	/**
+	 * @brief has a chunk been modified since the tracking was enabled or the flags were cleared
+	 * @return true if the chunk is dirty or if the tracking is disabled
+	 */
+	inline bool is_dirty(uint32 chunk) const
+	{
+		return !dirty_tracking_ || chunk >= nb_dirty_flags_ || dirty_chunks_[chunk].load(std::memory_order_relaxed) != 0u;
+	}
+
+	uint32 nb_dirty_chunks() const
+	{
+		uint32 result = 0u;
+		for (uint32 i = 0u, nb = this->nb_chunks(); i < nb; ++i)
+			result += is_dirty(i) ? 1u : 0u;
+		return result;
+	}
+
+	void clear_dirty_chunks()
+	{
+		for (uint32 i = 0u; i < nb_dirty_flags_; ++i)
+			dirty_chunks_[i].store(0u, std::memory_order_relaxed);
+	}
+
+protected:
+
+	/**
+	 * @brief flag a chunk as dirty (thread safe, the flag is only written if it is not already set)
+	 */
+	inline void mark_dirty(uint32 chunk)
+	{
+		if (dirty_tracking_ && chunk < nb_dirty_flags_ && dirty_chunks_[chunk].load(std::memory_order_relaxed) == 0u)
+			dirty_chunks_[chunk].store(1u, std::memory_order_relaxed);
+	}
+
+	inline void mark_all_dirty()
+	{
+		nb_dirty_flags_ = 0u;
+		resize_dirty_flags(this->nb_chunks());
+	}
+
+	/**
+	 * @brief follow a change of the number of chunks (the new chunks are dirty)
+	 */
+	void resize_dirty_flags(uint32 nb_chunks)
+	{
+		if (!dirty_tracking_)
+			return;
+		if (nb_chunks > dirty_flags_capacity_)
+		{
+			const uint32 capacity = std::max(nb_chunks, 2u * dirty_flags_capacity_);
+			std::unique_ptr<std::atomic<uint8>[]> flags(new std::atomic<uint8>[capacity]);
+			for (uint32 i = 0u; i < nb_dirty_flags_; ++i)
+				flags[i].store(dirty_chunks_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			dirty_chunks_.swap(flags);
+			dirty_flags_capacity_ = capacity;
+		}
+		for (uint32 i = nb_dirty_flags_; i < nb_chunks; ++i)
+			dirty_chunks_[i].store(1u, std::memory_order_relaxed);
+		nb_dirty_flags_ = nb_chunks;
+	}
+
+public:
+
+	/**
+	 * @brief set the allocator of the chunks of the array
+	 * A chunk must be released by the allocator that created it, so the allocator can only be changed when the array has no chunk.
+	 * @return false (and the allocator is unchanged) if the array has chunks
+	 */
+	bool set_chunk_allocator(const ChunkAllocator& allocator)
+	{
+		if (this->nb_chunks() != 0u)
+		{
+			cgogn_log_warning("set_chunk_allocator") << "Cannot change the allocator of the non empty chunk array \"" << name_ << "\".";
+			return false;
+		}
+		allocator_ = allocator;
+		return true;
+	}
+
 	virtual std::string nested_type_name() const = 0;
 
 	virtual uint32 nb_components() const = 0;
@@ -133,6 +249,63 @@ public:
 	 */
 	virtual uint32 capacity() const = 0;
 
+	/**
+	 * @brief is the data stored with a structure of arrays layout (one chunk per component)
+	 * @return true for a ChunkArraySoA, in this case chunks_pointers returns nb_components() pointers per chunk
+	 */
+	virtual bool soa_layout() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief can the chunks of the array be saved as raw memory and used in place from a mapped file
+	 * @see ChunkArrayContainer::save_mapped
+	 */
+	virtual bool is_mappable() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief replace the chunks of the array by chunks stored in a mapped file
+	 * The data is not copied: the system duplicates a page of the mapping on its first write.
+	 * @param chunks addresses of the chunks in the mapping
+	 * @param file the mapped file, kept alive as long as the array uses its chunks
+	 * @return false if the array is not mappable
+	 */
+	virtual bool attach_mapped_chunks(const std::vector<char*>& chunks, const std::shared_ptr<MappedFile>& file)
+	{
+		unused_parameters(chunks, file);
+		return false;
+	}
+
+	/**
+	 * @brief write the raw memory of a chunk (only for mappable arrays)
+	 */
+	virtual void save_raw_chunk(std::ostream& fs, uint32 chunk) const
+	{
+		unused_parameters(fs, chunk);
+		cgogn_assert_not_reached("save_raw_chunk called on a non mappable array");
+	}
+
+	/**
+	 * @brief read the raw memory of a chunk written by save_raw_chunk (only for mappable arrays)
+	 */
+	virtual bool load_raw_chunk(std::istream& fs, uint32 chunk)
+	{
+		unused_parameters(fs, chunk);
+		return false;
+	}
+
+	/**
+	 * @brief get the number of chunks of the array that are stored in a mapped file
+	 */
+	virtual uint32 nb_mapped_chunks() const
+	{
+		return 0u;
+	}
+
 	/**
 	 * @brief return a vector with pointers to all chunks
 	 * @param byte_block_size filled with CHUNK_SIZE*sizeof(T)
@@ -0,0 +1,510 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_CONTAINER_CHUNK_ARRAY_SOA_H_
+#define CGOGN_CORE_CONTAINER_CHUNK_ARRAY_SOA_H_
+
+#include <array>
+#include <vector>
+#include <type_traits>
+
+#include <cgogn/core/container/chunk_array_gen.h>
+#include <cgogn/core/utils/name_types.h>
+#include <cgogn/core/utils/serialization.h>
+#include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/assert.h>
+#include <cgogn/core/utils/logger.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief traits of the types that can be stored component by component (structure of arrays)
+ * A type T is SoA compatible if it is a fixed size packed array of arithmetic values
+ * (Eigen::Vector3f, Eigen::Vector3d, Vec_T<std::array<float64,3>>, ...).
+ */
+template <typename T>
+struct soa_traits
+{
+	using Scalar = array_data_type<T>;
+	static const uint32 NB_COMPONENTS = uint32(sizeof(T) / sizeof(Scalar));
+	static const bool value = std::is_arithmetic<Scalar>::value && NB_COMPONENTS > 1u && sizeof(T) == NB_COMPONENTS * sizeof(Scalar);
+};
+
+/**
+ * @brief reference on an element of a ChunkArraySoA
+ * The components of the element are scattered in several chunks, this proxy
+ * gathers them on read (conversion to T) and scatters them on write (operator=).
+ */
+template <typename T>
+class SoAReference
+{
+public:
+
+	using Self = SoAReference<T>;
+	using Scalar = typename soa_traits<T>::Scalar;
+	static const uint32 NB_COMPONENTS = soa_traits<T>::NB_COMPONENTS;
+
+	inline SoAReference(const std::array<Scalar*, NB_COMPONENTS>& components) :
+		components_(components)
+	{}
+
+	inline SoAReference(const Self&) = default;
+
+	inline T value() const
+	{
+		T v;
+		Scalar* p = reinterpret_cast<Scalar*>(&v);
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			p[k] = *components_[k];
+		return v;
+	}
+
+	inline operator T() const
+	{
+		return value();
+	}
+
+	inline Scalar& operator[](uint32 k) const
+	{
+		cgogn_assert(k < NB_COMPONENTS);
+		return *components_[k];
+	}
+
+	inline const Self& operator=(const T& v) const
+	{
+		const Scalar* p = reinterpret_cast<const Scalar*>(&v);
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			*components_[k] = p[k];
+		return *this;
+	}
+
+	// assign the referenced value (a reference is never rebound)
+	inline const Self& operator=(const Self& r) const
+	{
+		return this->operator=(r.value());
+	}
+
+	inline const Self& operator+=(const T& v) const
+	{
+		const Scalar* p = reinterpret_cast<const Scalar*>(&v);
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			*components_[k] += p[k];
+		return *this;
+	}
+
+	inline const Self& operator-=(const T& v) const
+	{
+		const Scalar* p = reinterpret_cast<const Scalar*>(&v);
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			*components_[k] -= p[k];
+		return *this;
+	}
+
+	inline const Self& operator*=(Scalar s) const
+	{
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			*components_[k] *= s;
+		return *this;
+	}
+
+	inline const Self& operator/=(Scalar s) const
+	{
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			*components_[k] /= s;
+		return *this;
+	}
+
+	friend inline T operator+(const Self& a, const T& b) { return T(a.value() + b); }
+	friend inline T operator+(const T& a, const Self& b) { return T(a + b.value()); }
+	friend inline T operator+(const Self& a, const Self& b) { return T(a.value() + b.value()); }
+	friend inline T operator-(const Self& a, const T& b) { return T(a.value() - b); }
+	friend inline T operator-(const T& a, const Self& b) { return T(a - b.value()); }
+	friend inline T operator-(const Self& a, const Self& b) { return T(a.value() - b.value()); }
+	friend inline T operator*(const Self& a, Scalar s) { return T(a.value() * s); }
+	friend inline T operator*(Scalar s, const Self& a) { return T(a.value() * s); }
+	friend inline T operator/(const Self& a, Scalar s) { return T(a.value() / s); }
+
+private:
+
+	std::array<Scalar*, NB_COMPONENTS> components_;
+};
+
+/**
+ *	@brief chunk array class storage with a structure of arrays layout
+ *	Each component of the elements is stored in its own chunk: the chunk c of the array is made of
+ *	NB_COMPONENTS chunks of CHUNK_SIZE Scalar, so that kernels that work on one component at a time
+ *	read contiguous memory and use all the SIMD lanes.
+ *	The elements are accessed through a SoAReference proxy.
+ *	@tparam CHUNK_SIZE size of each chunk (in elements)
+ *	@tparam T type of stored data (must satisfy soa_traits<T>::value)
+ */
+template <uint32 CHUNK_SIZE, typename T>
+class ChunkArraySoA : public ChunkArrayGen<CHUNK_SIZE>
+{
+public:
+
+	static_assert(soa_traits<T>::value, "ChunkArraySoA can only store packed arrays of arithmetic values");
+
+	using Inherit = ChunkArrayGen<CHUNK_SIZE>;
+	using Self = ChunkArraySoA<CHUNK_SIZE, T>;
+	using value_type = T;
+	using Scalar = typename soa_traits<T>::Scalar;
+	using reference = SoAReference<T>;
+	static const uint32 NB_COMPONENTS = soa_traits<T>::NB_COMPONENTS;
+
+protected:
+
+	// component k of chunk c is stored in table_data_[c * NB_COMPONENTS + k]
+	std::vector<Scalar*> table_data_;
+
+public:
+
+	inline ChunkArraySoA(const std::string& name) :
+		Inherit(name, name_of_type(T()))
+	{
+		table_data_.reserve(1024u);
+	}
+
+	inline ChunkArraySoA() : Inherit("", name_of_type(T()))
+	{
+		table_data_.reserve(1024u);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ChunkArraySoA);
+
+	~ChunkArraySoA() override
+	{
+		for (auto chunk : table_data_)
+			this->allocator_.deallocate(chunk, CHUNK_SIZE);
+	}
+
+	std::string nested_type_name() const override
+	{
+		return name_of_type(Scalar());
+	}
+
+	uint32 nb_components() const override
+	{
+		return NB_COMPONENTS;
+	}
+
+	uint32 element_size() const override
+	{
+		return sizeof(T);
+	}
+
+	uint32 nb_chunks() const override
+	{
+		return uint32(table_data_.size()) / NB_COMPONENTS;
+	}
+
+	uint32 capacity() const override
+	{
+		return nb_chunks() * CHUNK_SIZE;
+	}
+
+	bool soa_layout() const override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief return a vector with pointers to all component chunks
+	 * The NB_COMPONENTS component chunks of each chunk are consecutive in the returned vector.
+	 * @param byte_chunk_size filled with CHUNK_SIZE*sizeof(Scalar)
+	 * @return the vector of pointers
+	 */
+	std::vector<const void*> chunks_pointers(uint32& byte_chunk_size) const override
+	{
+		byte_chunk_size = CHUNK_SIZE * sizeof(Scalar);
+		return std::vector<const void*>(table_data_.begin(), table_data_.end());
+	}
+
+	std::unique_ptr<Inherit> clone(const std::string& clone_name) const override
+	{
+		if (clone_name == this->name_)
+			return nullptr;
+		return std::unique_ptr<Inherit>(new Self(clone_name));
+	}
+
+	bool swap_data(Inherit* cag) override
+	{
+		Self* ca = dynamic_cast<Self*>(cag);
+		if (!ca)
+		{
+			cgogn_log_warning("swap_data") << "Trying to swap attribute of different types";
+			return false;
+		}
+		table_data_.swap(ca->table_data_);
+		std::swap(this->allocator_, ca->allocator_);
+		this->mark_all_dirty();
+		ca->mark_all_dirty();
+		return true;
+	}
+
+	void add_chunk() override
+	{
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			table_data_.push_back(this->allocator_.template allocate<Scalar>(CHUNK_SIZE));
+		this->resize_dirty_flags(nb_chunks());
+	}
+
+	void set_nb_chunks(uint32 nbc) override
+	{
+		if (nbc >= nb_chunks())
+			this->allocator_.allocate(CHUNK_SIZE, table_data_, (nbc - nb_chunks()) * NB_COMPONENTS);
+		else
+		{
+			for (std::size_t i = std::size_t(nbc) * NB_COMPONENTS; i < table_data_.size(); ++i)
+				this->allocator_.deallocate(table_data_[i], CHUNK_SIZE);
+			table_data_.resize(std::size_t(nbc) * NB_COMPONENTS);
+		}
+		this->resize_dirty_flags(nbc);
+	}
+
+	void clear() override
+	{
+		for (auto chunk : table_data_)
+			this->allocator_.deallocate(chunk, CHUNK_SIZE);
+		table_data_.clear();
+		table_data_.shrink_to_fit();
+		table_data_.reserve(1024u);
+		this->resize_dirty_flags(0u);
+	}
+
+	void copy_element(uint32 dst, uint32 src) override
+	{
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			component(k, dst) = component(k, src);
+	}
+
+	void copy_external_element(uint32 dst, Inherit* cag_src, uint32 src) override
+	{
+		Self* ca = static_cast<Self*>(cag_src);
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			component(k, dst) = ca->component(k, src);
+	}
+
+	void swap_elements(uint32 idx1, uint32 idx2) override
+	{
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			std::swap(component(k, idx1), component(k, idx2));
+	}
+
+	/**
+	 * @brief save the array with the layout of a ChunkArray<CHUNK_SIZE,T>
+	 * The data is reloaded as a regular (AoS) ChunkArray.
+	 */
+	void save(std::ostream& fs, uint32 nb_lines) const override
+	{
+		cgogn_assert(fs.good());
+		cgogn_assert(nb_lines / CHUNK_SIZE <= nb_chunks());
+
+		std::size_t chunk_bytes = 0;
+		if (nb_lines == 0)
+		{
+			serialization::save(fs, &chunk_bytes, 1);
+			serialization::save(fs, &nb_lines, 1);
+			return;
+		}
+
+		std::vector<T> buffer(CHUNK_SIZE);
+		chunk_bytes = serialization::data_length(buffer.data(), nb_lines);
+		serialization::save(fs, &chunk_bytes, 1);
+		serialization::save(fs, &nb_lines, 1);
+
+		for (uint32 first = 0u; first < nb_lines; first += CHUNK_SIZE)
+		{
+			const uint32 nb = std::min(CHUNK_SIZE, nb_lines - first);
+			for (uint32 i = 0u; i < nb; ++i)
+				buffer[i] = this->operator[](first + i);
+			serialization::save(fs, buffer.data(), nb);
+		}
+
+		cgogn_assert(fs.good());
+	}
+
+	bool load(std::istream& fs) override
+	{
+		cgogn_assert(fs.good());
+
+		std::size_t chunk_bytes;
+		serialization::load(fs, &chunk_bytes, 1);
+		uint32 nb_lines;
+		serialization::load(fs, &nb_lines, 1);
+		if (nb_lines == 0)
+			return true;
+
+		this->set_nb_chunks((nb_lines + CHUNK_SIZE - 1u) / CHUNK_SIZE);
+
+		std::vector<T> buffer(CHUNK_SIZE);
+		for (uint32 first = 0u; first < nb_lines; first += CHUNK_SIZE)
+		{
+			const uint32 nb = std::min(CHUNK_SIZE, nb_lines - first);
+			serialization::load(fs, buffer.data(), nb);
+			for (uint32 i = 0u; i < nb; ++i)
+				this->operator[](first + i) = buffer[i];
+		}
+		cgogn_assert(fs.good());
+
+		return true;
+	}
+
+	void export_element(uint32 idx, std::ostream& o, bool binary, bool little_endian, std::size_t precision) const override
+	{
+		const T v = this->operator[](idx);
+		switch (precision)
+		{
+			case 1ul: serialization::ostream_writer<T, 1ul>(o, v, binary, little_endian); break;
+			case 2ul: serialization::ostream_writer<T, 2ul>(o, v, binary, little_endian); break;
+			case 4ul: serialization::ostream_writer<T, 4ul>(o, v, binary, little_endian); break;
+			default:  serialization::ostream_writer<T, 8ul>(o, v, binary, little_endian); break;
+		}
+	}
+
+	void import_element(uint32 idx, std::istream& in) override
+	{
+		T v;
+		serialization::parse(in, v);
+		this->operator[](idx) = v;
+	}
+
+	const void* element_ptr(uint32) const override
+	{
+		return nullptr; // shall not be used with ChunkArraySoA (elements are not contiguous)
+	}
+
+	/**
+	 * @brief access to the component k of the element i
+	 */
+	inline Scalar& component(uint32 k, uint32 i)
+	{
+		cgogn_assert(i / CHUNK_SIZE < nb_chunks());
+		this->mark_dirty(i / CHUNK_SIZE);
+		return table_data_[(i / CHUNK_SIZE) * NB_COMPONENTS + k][i % CHUNK_SIZE];
+	}
+
+	inline const Scalar& component(uint32 k, uint32 i) const
+	{
+		cgogn_assert(i / CHUNK_SIZE < nb_chunks());
+		return table_data_[(i / CHUNK_SIZE) * NB_COMPONENTS + k][i % CHUNK_SIZE];
+	}
+
+	/**
+	 * @brief get the data of the component k of a chunk
+	 * @param chunk index of the chunk
+	 * @param k index of the component
+	 * @return pointer on the CHUNK_SIZE values of the component
+	 */
+	inline Scalar* chunk_data(uint32 chunk, uint32 k)
+	{
+		cgogn_message_assert(chunk < nb_chunks(), "chunk_data: chunk index out of bounds");
+		this->mark_dirty(chunk);
+		return table_data_[chunk * NB_COMPONENTS + k];
+	}
+
+	inline const Scalar* chunk_data(uint32 chunk, uint32 k) const
+	{
+		cgogn_message_assert(chunk < nb_chunks(), "chunk_data: chunk index out of bounds");
+		return table_data_[chunk * NB_COMPONENTS + k];
+	}
+
+	/**
+	 * @brief operator[]
+	 * @param i index of element to access
+	 * @return a proxy on the element
+	 */
+	inline reference operator[](uint32 i)
+	{
+		cgogn_assert(i / CHUNK_SIZE < nb_chunks());
+		this->mark_dirty(i / CHUNK_SIZE);
+		std::array<Scalar*, NB_COMPONENTS> components;
+		Scalar* const* chunk = &table_data_[(i / CHUNK_SIZE) * NB_COMPONENTS];
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			components[k] = chunk[k] + (i % CHUNK_SIZE);
+		return reference(components);
+	}
+
+	/**
+	 * @brief const operator[]
+	 * @param i index of element to access
+	 * @return a copy of the element
+	 */
+	inline T operator[](uint32 i) const
+	{
+		cgogn_assert(i / CHUNK_SIZE < nb_chunks());
+		T v;
+		Scalar* p = reinterpret_cast<Scalar*>(&v);
+		Scalar* const* chunk = &table_data_[(i / CHUNK_SIZE) * NB_COMPONENTS];
+		for (uint32 k = 0u; k < NB_COMPONENTS; ++k)
+			p[k] = chunk[k][i % CHUNK_SIZE];
+		return v;
+	}
+
+	inline void set_value(uint32 i, const T& v)
+	{
+		this->operator[](i) = v;
+	}
+
+	inline void set_all_values(const T& v)
+	{
+		this->mark_all_dirty();
+		const Scalar* p = reinterpret_cast<const Scalar*>(&v);
+		for (std::size_t c = 0u; c < table_data_.size(); ++c)
+			std::fill(table_data_[c], table_data_[c] + CHUNK_SIZE, p[c % NB_COMPONENTS]);
+	}
+
+	void copy(const Inherit& cag_src) override
+	{
+		clear();
+		const Self* ca = dynamic_cast<const Self*>(&cag_src);
+		if (ca == nullptr)
+		{
+			cgogn_log_error("ChunkArraySoA") << "trying to copy between different types";
+			return;
+		}
+		set_nb_chunks(ca->nb_chunks());
+		copy_data(cag_src);
+	}
+
+	void copy_data(const Inherit& cag_src) override
+	{
+		const Self* ca = dynamic_cast<const Self*>(&cag_src);
+		if (ca == nullptr)
+		{
+			cgogn_log_error("ChunkArraySoA") << "trying to copy between different types";
+			return;
+		}
+
+		cgogn_message_assert(ca->nb_chunks() == this->nb_chunks(), "copy_data only with same sized ChunkArraySoA");
+		this->mark_all_dirty();
+
+		for (std::size_t c = 0u; c < table_data_.size(); ++c)
+			std::copy(ca->table_data_[c], ca->table_data_[c] + CHUNK_SIZE, table_data_[c]);
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_CONTAINER_CHUNK_ARRAY_SOA_H_
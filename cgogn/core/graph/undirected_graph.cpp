@@ -32,6 +32,8 @@ template class CGOGN_CORE_API UndirectedGraph_T<UndirectedGraphType>;
 template class CGOGN_CORE_API UndirectedGraphBuilder_T<UndirectedGraph>;
 template class CGOGN_CORE_API DartMarker<UndirectedGraph>;
 template class CGOGN_CORE_API DartMarkerStore<UndirectedGraph>;
+template class CGOGN_CORE_API DartMarkerEpoch<UndirectedGraph>;
+template class CGOGN_CORE_API DartMarkerLocal<UndirectedGraph>;
 template class CGOGN_CORE_API DartMarkerNoUnmark<UndirectedGraph>;
 template class CGOGN_CORE_API CellMarker<UndirectedGraph, UndirectedGraph::Vertex::ORBIT>;
 template class CGOGN_CORE_API CellMarker<UndirectedGraph, UndirectedGraph::Edge::ORBIT>;
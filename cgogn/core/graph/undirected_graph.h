@@ -70,6 +70,8 @@ public:
 
 	using DartMarker = typename cgogn::DartMarker<Self>;
 	using DartMarkerStore = typename cgogn::DartMarkerStore<Self>;
+	using DartMarkerEpoch = typename cgogn::DartMarkerEpoch<Self>;
+	using DartMarkerLocal = typename cgogn::DartMarkerLocal<Self>;
 	using DartMarkerNoUnmark = typename cgogn::DartMarkerNoUnmark<Self>;
 
 	template <Orbit ORBIT>
@@ -78,6 +80,8 @@ public:
 	using CellMarkerNoUnmark = typename cgogn::CellMarkerNoUnmark<Self, ORBIT>;
 	template <Orbit ORBIT>
 	using CellMarkerStore = typename cgogn::CellMarkerStore<Self, ORBIT>;
+	template <Orbit ORBIT>
+	using CellMarkerEpoch = typename cgogn::CellMarkerEpoch<Self, ORBIT>;
 
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
@@ -628,6 +632,8 @@ extern template class CGOGN_CORE_API UndirectedGraph_T<UndirectedGraphType>;
 extern template class CGOGN_CORE_API UndirectedGraphBuilder_T<UndirectedGraph>;
 extern template class CGOGN_CORE_API DartMarker<UndirectedGraph>;
 extern template class CGOGN_CORE_API DartMarkerStore<UndirectedGraph>;
+extern template class CGOGN_CORE_API DartMarkerEpoch<UndirectedGraph>;
+extern template class CGOGN_CORE_API DartMarkerLocal<UndirectedGraph>;
 extern template class CGOGN_CORE_API DartMarkerNoUnmark<UndirectedGraph>;
 extern template class CGOGN_CORE_API CellMarker<UndirectedGraph, UndirectedGraph::Vertex::ORBIT>;
 extern template class CGOGN_CORE_API CellMarker<UndirectedGraph, UndirectedGraph::Edge::ORBIT>;
@@ -382,4 +382,43 @@ TYPED_TEST(CellMarkerTest, unmark_all)
 	});
 }
 
+TYPED_TEST(CellMarkerTest, epoch)
+{
+	using Vertex = typename TypeParam::Vertex;
+	using Face = typename TypeParam::Face;
+	using VertexMarker = typename TypeParam::template CellMarkerEpoch<Vertex::ORBIT>;
+	using FaceMarker = typename TypeParam::template CellMarkerEpoch<Face::ORBIT>;
+
+	{
+		VertexMarker vm(this->map);
+		FaceMarker fm(this->map);
+		uint32 nb_vertices = 0u;
+		this->map.foreach_cell([&](Vertex v)
+		{
+			EXPECT_FALSE(vm.is_marked(v));
+			vm.mark(v);
+			++nb_vertices;
+		});
+		EXPECT_EQ(nb_vertices, vm.nb_marked());
+		this->map.foreach_dart([&](Dart d)
+		{
+			if (!this->map.is_boundary(d))
+			{
+				EXPECT_TRUE(vm.is_marked(Vertex(d)));
+				fm.mark(Face(d));
+				EXPECT_TRUE(fm.is_marked(Face(d)));
+				fm.unmark(Face(d));
+				EXPECT_FALSE(fm.is_marked(Face(d)));
+			}
+		});
+		vm.unmark_all();
+		EXPECT_EQ(0u, vm.nb_marked());
+		this->map.foreach_cell([&](Vertex v) { vm.mark(v); });
+	}
+
+	// a marker reusing the released stamp attribute starts with no marked cell
+	VertexMarker vm(this->map);
+	this->map.foreach_cell([&](Vertex v) { EXPECT_FALSE(vm.is_marked(v)); });
+}
+
 } // namespace cell_marker_test
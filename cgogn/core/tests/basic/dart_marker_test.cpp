@@ -378,4 +378,110 @@ TYPED_TEST(DartMarkerTest, unmark_all)
 	});
 }
 
+TYPED_TEST(DartMarkerTest, epoch)
+{
+	using Vertex = typename TypeParam::Vertex;
+	using DartMarkerEpoch = typename TypeParam::DartMarkerEpoch;
+
+	Dart first;
+	this->map.foreach_dart([&](Dart d) -> bool { first = d; return false; });
+	{
+		DartMarkerEpoch dm(this->map);
+		this->map.foreach_dart([&](Dart d)
+		{
+			EXPECT_FALSE(dm.is_marked(d));
+			dm.mark_orbit(Vertex(d));
+			this->map.foreach_dart_of_orbit(Vertex(d), [&](Dart d2) { EXPECT_TRUE(dm.is_marked(d2)); });
+			dm.unmark_orbit(Vertex(d));
+			EXPECT_FALSE(dm.is_marked(d));
+			dm.mark(d);
+		});
+
+		dm.unmark(first);
+		EXPECT_FALSE(dm.is_marked(first));
+
+		dm.unmark_all();
+		this->map.foreach_dart([&](Dart d) { EXPECT_FALSE(dm.is_marked(d)); });
+
+		// the epoch wraps around after 65535 unmark_all, the stamps are then reset
+		dm.mark(first);
+		for (uint32 i = 0u; i < 65535u; ++i)
+			dm.unmark_all();
+		this->map.foreach_dart([&](Dart d) { EXPECT_FALSE(dm.is_marked(d)); });
+		dm.mark(first);
+	}
+
+	// a marker reusing the released stamp attribute starts with no marked dart
+	DartMarkerEpoch dm(this->map);
+	this->map.foreach_dart([&](Dart d) { EXPECT_FALSE(dm.is_marked(d)); });
+	EXPECT_FALSE(dm.is_marked(first));
+}
+
+TYPED_TEST(DartMarkerTest, local)
+{
+	using Vertex = typename TypeParam::Vertex;
+	using Face = typename TypeParam::Face;
+	using DartMarkerLocal = typename TypeParam::DartMarkerLocal;
+	using SmallDartMarkerLocal = cgogn::DartMarkerLocal<TypeParam, 4u>;
+
+	DartMarkerLocal dm(this->map);
+	SmallDartMarkerLocal sdm(this->map);
+	std::vector<Dart> darts;
+	this->map.foreach_dart([&](Dart d) { darts.push_back(d); });
+
+	for (Dart d : darts)
+	{
+		EXPECT_FALSE(dm.is_marked(d));
+		EXPECT_FALSE(sdm.is_marked(d));
+		dm.mark(d);
+		sdm.mark(d);
+	}
+	EXPECT_EQ(darts.size() > 128u, dm.uses_fallback());
+	EXPECT_TRUE(sdm.uses_fallback());
+
+	// unmark one dart out of two (the other ones must stay marked)
+	for (uint32 i = 0u; i < uint32(darts.size()); ++i)
+	{
+		if (i % 2u == 0u)
+		{
+			dm.unmark(darts[i]);
+			sdm.unmark(darts[i]);
+		}
+	}
+	for (uint32 i = 0u; i < uint32(darts.size()); ++i)
+	{
+		EXPECT_EQ(i % 2u == 1u, dm.is_marked(darts[i]));
+		EXPECT_EQ(i % 2u == 1u, sdm.is_marked(darts[i]));
+	}
+
+	dm.unmark_all();
+	sdm.unmark_all();
+	EXPECT_FALSE(sdm.uses_fallback());
+	for (Dart d : darts)
+	{
+		EXPECT_FALSE(dm.is_marked(d));
+		EXPECT_FALSE(sdm.is_marked(d));
+	}
+
+	Face f(darts.front());
+	sdm.mark_orbit(f);
+	this->map.foreach_dart_of_orbit(f, [&](Dart d) { EXPECT_TRUE(sdm.is_marked(d)); });
+	sdm.unmark_orbit(f);
+	this->map.foreach_dart_of_orbit(f, [&](Dart d) { EXPECT_FALSE(sdm.is_marked(d)); });
+
+	// the traversals based on local markers visit each dart of the vertices once
+	uint32 nb_darts = 0u;
+	this->map.foreach_cell([&](Vertex v)
+	{
+		this->map.foreach_dart_of_orbit(v, [&](Dart d)
+		{
+			EXPECT_TRUE(this->map.same_cell(v, Vertex(d)));
+			EXPECT_FALSE(dm.is_marked(d));
+			dm.mark(d);
+			++nb_darts;
+		});
+	});
+	EXPECT_LE(nb_darts, uint32(darts.size()));
+}
+
 } // namespace dart_marker_test
@@ -171,6 +171,280 @@ TEST_F(CMap2Test, random_map_generators)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+/**
+ * \brief Parallel reductions over cells combine the values of all the cells
+ */
+TEST_F(CMap2Test, chunk_allocator)
+{
+	EXPECT_TRUE(cmap_.set_chunk_allocator(cgogn::ChunkAllocator(cgogn::ChunkAllocationMode::FIRST_TOUCH, false)));
+	add_faces(NB_MAX);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_FALSE(cmap_.set_chunk_allocator(cgogn::ChunkAllocator()));
+
+	cmap_.clear_and_remove_attributes();
+	EXPECT_TRUE(cmap_.set_chunk_allocator(cgogn::ChunkAllocator()));
+}
+
+TEST_F(CMap2Test, save_load_mapped)
+{
+	if (!cgogn::MappedFile::is_supported())
+		return;
+
+	add_faces(NB_MAX);
+	cmap_.add_attribute<float64, Vertex>("scalar");
+	cmap_.add_attribute<std::string, Face>("label");
+	CMap2::VertexAttribute<float64> scalar = cmap_.get_attribute<float64, Vertex>("scalar");
+	CMap2::FaceAttribute<std::string> label = cmap_.get_attribute<std::string, Face>("label");
+	cmap_.foreach_cell([&] (Vertex v) { scalar[v] = float64(cmap_.embedding(v)); });
+	cmap_.foreach_cell([&] (Face f) { label[f] = std::to_string(cmap_.codegree(f)); });
+
+	const std::string filename("cgogn_cmap2_test.map");
+	EXPECT_TRUE(cmap_.save_mapped(filename));
+
+	CMap2 map2;
+	EXPECT_TRUE(map2.load_mapped(filename));
+	EXPECT_TRUE(map2.check_map_integrity());
+	EXPECT_EQ(map2.nb_cells<Vertex>(), cmap_.nb_cells<Vertex>());
+	EXPECT_EQ(map2.nb_cells<Edge>(), cmap_.nb_cells<Edge>());
+	EXPECT_EQ(map2.nb_cells<Face>(), cmap_.nb_cells<Face>());
+	EXPECT_EQ(map2.nb_darts(), cmap_.nb_darts());
+	cmap_.foreach_dart([&] (Dart d) { EXPECT_EQ(map2.is_boundary(d), cmap_.is_boundary(d)); });
+
+	CMap2::VertexAttribute<float64> scalar2 = map2.get_attribute<float64, Vertex>("scalar");
+	CMap2::FaceAttribute<std::string> label2 = map2.get_attribute<std::string, Face>("label");
+	ASSERT_TRUE(scalar2.is_valid());
+	ASSERT_TRUE(label2.is_valid());
+	map2.foreach_cell([&] (Vertex v) { EXPECT_EQ(scalar2[v], scalar[Vertex(v.dart)]); });
+	map2.foreach_cell([&] (Face f) { EXPECT_EQ(label2[f], std::to_string(map2.codegree(f))); });
+
+	// edit the loaded map
+	std::vector<Edge> edges;
+	map2.foreach_cell([&] (Edge e) { if (edges.size() < 10u) edges.push_back(e); });
+	for (Edge e : edges)
+		map2.cut_edge(e);
+	EXPECT_TRUE(map2.check_map_integrity());
+
+	// the file is not modified
+	CMap2 map3;
+	EXPECT_TRUE(map3.load_mapped(filename));
+	EXPECT_EQ(map3.nb_cells<Edge>(), cmap_.nb_cells<Edge>());
+	std::remove(filename.c_str());
+}
+
+TEST_F(CMap2Test, save_apply_delta)
+{
+	if (!cgogn::MappedFile::is_supported())
+		return;
+
+	add_faces(NB_MAX);
+	cmap_.add_attribute<float64, Vertex>("scalar");
+	cmap_.add_attribute<std::string, Face>("label");
+	CMap2::VertexAttribute<float64> scalar = cmap_.get_attribute<float64, Vertex>("scalar");
+	CMap2::FaceAttribute<std::string> label = cmap_.get_attribute<std::string, Face>("label");
+	cmap_.foreach_cell([&] (Vertex v) { scalar[v] = float64(cmap_.embedding(v)); });
+	cmap_.foreach_cell([&] (Face f) { label[f] = std::to_string(cmap_.codegree(f)); });
+
+	const std::string filename("cgogn_cmap2_test.map");
+	const std::string delta_filename("cgogn_cmap2_test.delta");
+	EXPECT_TRUE(cmap_.save_mapped(filename));
+	cmap_.set_dirty_tracking(true);
+
+	// edit the map
+	std::vector<Edge> edges;
+	cmap_.foreach_cell([&] (Edge e) { if (edges.size() < 10u) edges.push_back(e); });
+	for (Edge e : edges)
+		scalar[cmap_.cut_edge(e)] = -1.0;
+	cmap_.remove_attribute(label);
+	EXPECT_TRUE(cmap_.save_delta(delta_filename));
+
+	CMap2 map2;
+	EXPECT_TRUE(map2.load_mapped(filename));
+	EXPECT_TRUE(map2.apply_delta(delta_filename));
+	EXPECT_TRUE(map2.check_map_integrity());
+	EXPECT_EQ(map2.nb_cells<Vertex>(), cmap_.nb_cells<Vertex>());
+	EXPECT_EQ(map2.nb_cells<Edge>(), cmap_.nb_cells<Edge>());
+	EXPECT_EQ(map2.nb_cells<Face>(), cmap_.nb_cells<Face>());
+	EXPECT_EQ(map2.nb_darts(), cmap_.nb_darts());
+	cmap_.foreach_dart([&] (Dart d) { EXPECT_EQ(map2.is_boundary(d), cmap_.is_boundary(d)); });
+	EXPECT_FALSE((map2.get_attribute<std::string, Face>("label").is_valid()));
+
+	CMap2::VertexAttribute<float64> scalar2 = map2.get_attribute<float64, Vertex>("scalar");
+	ASSERT_TRUE(scalar2.is_valid());
+	const CMap2::VertexAttribute<float64>& const_scalar = scalar; // read only access does not mark the chunks
+	map2.foreach_cell([&] (Vertex v) { EXPECT_EQ(scalar2[v], const_scalar[Vertex(v.dart)]); });
+
+	// without edit, only the headers, the boundary marker and the holes are written
+	const std::string empty_filename("cgogn_cmap2_test_empty.delta");
+	EXPECT_TRUE(cmap_.save_delta(empty_filename));
+	EXPECT_TRUE(map2.apply_delta(empty_filename));
+	EXPECT_EQ(map2.nb_cells<Vertex>(), cmap_.nb_cells<Vertex>());
+	std::ifstream delta(delta_filename, std::ios::binary | std::ios::ate);
+	std::ifstream empty(empty_filename, std::ios::binary | std::ios::ate);
+	EXPECT_LT(empty.tellg(), delta.tellg() / 4);
+
+	std::remove(filename.c_str());
+	std::remove(delta_filename.c_str());
+	std::remove(empty_filename.c_str());
+}
+
+TEST_F(CMap2Test, reorder)
+{
+	add_closed_surfaces();
+	cmap_.remove_volume(Volume(darts_[0]));
+	cmap_.add_attribute<uint32, Vertex>("id");
+	CMap2::VertexAttribute<uint32> id = cmap_.get_attribute<uint32, Vertex>("id");
+	uint32 count = 0u;
+	cmap_.foreach_cell([&] (Vertex v) { id[v] = count++; });
+
+	// the edges given by the ids of their vertices do not depend on the order of the darts and vertices
+	auto edges = [&] ()
+	{
+		std::vector<std::pair<uint32, uint32>> result;
+		cmap_.foreach_dart([&] (Dart d)
+		{
+			result.emplace_back(id[Vertex(d)], id[Vertex(cmap_.phi1(d))]);
+		});
+		std::sort(result.begin(), result.end());
+		return result;
+	};
+	const std::vector<std::pair<uint32, uint32>> reference = edges();
+	const uint32 nb_vertices = cmap_.nb_cells<Vertex>();
+	const uint32 nb_faces = cmap_.nb_cells<Face>();
+	const uint32 nb_boundaries = cmap_.nb_boundaries();
+
+	// the darts remember their index before the reordering
+	cmap_.add_attribute<uint32, CDart>("old_index");
+	CMap2::CDartAttribute<uint32> old_index = cmap_.get_attribute<uint32, CDart>("old_index");
+	cmap_.foreach_dart([&] (Dart d) { old_index[CDart(d)] = d.index; });
+
+	const std::vector<Dart> order = cmap_.cuthill_mckee_dart_order();
+	EXPECT_EQ(order.size(), cmap_.nb_darts());
+	EXPECT_TRUE(cmap_.reorder_darts(order));
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_EQ(cmap_.topology_container().end(), cmap_.nb_darts());
+	EXPECT_EQ(cmap_.nb_cells<Vertex>(), nb_vertices);
+	EXPECT_EQ(cmap_.nb_cells<Face>(), nb_faces);
+	EXPECT_EQ(cmap_.nb_boundaries(), nb_boundaries);
+	EXPECT_TRUE(edges() == reference);
+	// the darts are stored in the breadth-first order
+	for (uint32 i = 0u; i < order.size(); ++i)
+		EXPECT_EQ(old_index[CDart(Dart(i))], order[i].index);
+
+	std::vector<uint32> vertices;
+	cmap_.foreach_cell([&] (Vertex v) { vertices.push_back(cmap_.embedding(v)); });
+	std::reverse(vertices.begin(), vertices.end());
+	EXPECT_FALSE(cmap_.reorder_cells<Vertex>(std::vector<uint32>(2u, 0u)));
+	EXPECT_TRUE(cmap_.reorder_cells<Vertex>(vertices));
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_EQ(cmap_.nb_cells<Vertex>(), nb_vertices);
+	EXPECT_TRUE(edges() == reference);
+	EXPECT_FALSE(cmap_.reorder_cells<Edge>(std::vector<uint32>()));
+}
+
+TEST_F(CMap2Test, marker_churn)
+{
+	add_faces(NB_MAX);
+	// fill the pools of the main thread
+	{
+		CMap2::DartMarker dm(cmap_);
+		CMap2::CellMarker<Vertex::ORBIT> cm(cmap_);
+		CMap2::DartMarkerEpoch dme(cmap_);
+	}
+	cmap_.reset_marker_churn();
+
+	for (uint32 i = 0u; i < 10u; ++i)
+	{
+		CMap2::DartMarker dm(cmap_);
+		CMap2::CellMarker<Vertex::ORBIT> cm(cmap_);
+		CMap2::DartMarkerEpoch dme(cmap_);
+	}
+	CMap2::MarkerChurn churn = cmap_.marker_churn();
+	EXPECT_EQ(churn.nb_acquired, 30u);
+	EXPECT_EQ(churn.nb_released, 30u);
+	EXPECT_EQ(churn.nb_created, 0u);
+
+	// markers created by the workers use the pools of the workers
+	cmap_.reset_marker_churn();
+	const uint32 nb_tasks = 4u * (cgogn::thread_pool()->nb_workers() + 1u);
+	std::vector<std::future<void>> futures;
+	for (uint32 i = 0u; i < nb_tasks; ++i)
+	{
+		futures.push_back(cgogn::thread_pool()->enqueue([this] ()
+		{
+			CMap2::DartMarker dm(cmap_);
+			dm.mark(Dart(0u));
+		}));
+	}
+	for (auto& f : futures)
+		f.wait();
+	churn = cmap_.marker_churn();
+	EXPECT_EQ(churn.nb_acquired, nb_tasks);
+	EXPECT_EQ(churn.nb_released, nb_tasks);
+	EXPECT_LE(churn.nb_created, uint64(cgogn::thread_pool()->nb_workers()));
+}
+
+TEST_F(CMap2Test, soa_attribute)
+{
+	using Vec = std::array<float32, 3>;
+	add_faces(NB_MAX);
+
+	cgogn::AttributeSoA<Vec, Vertex::ORBIT> soa = cmap_.add_soa_attribute<Vec, Vertex>("soa");
+	EXPECT_TRUE(soa.is_valid());
+	EXPECT_TRUE((cmap_.get_soa_attribute<Vec, Vertex>("soa").is_valid()));
+	EXPECT_FALSE((cmap_.get_attribute<Vec, Vertex>("soa").is_valid()));
+
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		const float32 e = float32(cmap_.embedding(v));
+		soa[v] = Vec({{e, -e, 1.0f}});
+	});
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		const Vec p = soa[v];
+		EXPECT_EQ(p[0], float32(cmap_.embedding(v)));
+		EXPECT_EQ(p[1], -p[0]);
+		EXPECT_EQ(soa[v][2], 1.0f);
+	});
+
+	EXPECT_TRUE(cmap_.remove_attribute(soa));
+	EXPECT_FALSE(soa.is_valid());
+}
+
+TEST_F(CMap2Test, parallel_reduce_cell)
+{
+	add_closed_surfaces();
+
+	const uint32 nb_vertices = cmap_.parallel_reduce_cell(0u,
+		[] (Vertex) { return 1u; },
+		[] (uint32 a, uint32 b) { return a + b; });
+	EXPECT_EQ(nb_vertices, cmap_.nb_cells<Vertex::ORBIT>());
+
+	uint32 nb_darts = 0u;
+	uint32 max_codegree = 0u;
+	cmap_.foreach_cell([&] (Face f)
+	{
+		nb_darts += cmap_.codegree(f);
+		max_codegree = std::max(max_codegree, cmap_.codegree(f));
+	});
+
+	const uint32 reduced_nb_darts = cmap_.parallel_reduce_cell(0u,
+		[&] (Face f) { return cmap_.codegree(f); },
+		[] (uint32 a, uint32 b) { return a + b; });
+	EXPECT_EQ(reduced_nb_darts, nb_darts);
+
+	const uint32 reduced_max_codegree = cmap_.parallel_reduce_cell(0u,
+		[&] (Face f) { return cmap_.codegree(f); },
+		[] (uint32 a, uint32 b) { return std::max(a, b); });
+	EXPECT_EQ(reduced_max_codegree, max_codegree);
+
+	const uint32 nb_large_faces = cmap_.parallel_reduce_cell(0u,
+		[] (Face) { return 1u; },
+		[] (uint32 a, uint32 b) { return a + b; },
+		[&] (Face f) { return cmap_.codegree(f) == max_codegree; });
+	EXPECT_GE(nb_large_faces, 1u);
+	EXPECT_LE(nb_large_faces * max_codegree, nb_darts);
+}
+
 /**
  * \brief Adding faces preserves the cell indexation
  */
@@ -185,6 +459,49 @@ TEST_F(CMap2Test, add_face)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+/**
+ * \brief Adding faces from index buffers sews the opposite darts of their edges
+ */
+TEST_F(CMap2Test, add_faces_bulk)
+{
+	// a closed tetrahedron and, in the second map, a triangle on its edge (0,1)
+	const std::vector<uint32> tetra = {0u, 1u, 2u, 0u, 2u, 3u, 0u, 3u, 1u, 1u, 3u, 2u};
+	std::vector<uint32> fin = tetra;
+	fin.insert(fin.end(), {0u, 1u, 4u});
+
+	CMap2 map;
+	MapBuilder mbuild(map);
+	mbuild.create_embedding<Vertex::ORBIT>();
+	for (uint32 i = 0u; i < 4u; ++i)
+		mbuild.attribute_container<Vertex::ORBIT>().insert_lines<1>();
+
+	bool non_manifold = true;
+	EXPECT_EQ(mbuild.add_faces_bulk({3u, 3u, 3u, 3u}, tetra, non_manifold), 0u);
+	EXPECT_FALSE(non_manifold);
+	EXPECT_TRUE(map.check_map_integrity());
+	EXPECT_TRUE(map.is_well_embedded<Vertex>());
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 4u);
+	EXPECT_EQ(map.nb_cells<Edge::ORBIT>(), 6u);
+	EXPECT_EQ(map.nb_cells<Face::ORBIT>(), 4u);
+	EXPECT_EQ(map.nb_boundaries(), 0u);
+
+	// the third face of the edge (0,1) is not sewn
+	CMap2 map2;
+	MapBuilder mbuild2(map2);
+	mbuild2.create_embedding<Vertex::ORBIT>();
+	for (uint32 i = 0u; i < 5u; ++i)
+		mbuild2.attribute_container<Vertex::ORBIT>().insert_lines<1>();
+
+	EXPECT_EQ(mbuild2.add_faces_bulk({3u, 3u, 3u, 3u, 3u}, fin, non_manifold), 3u);
+	EXPECT_TRUE(non_manifold);
+	EXPECT_EQ(mbuild2.close_map(), 1u);
+	map2.enforce_unique_orbit_embedding<Vertex::ORBIT>();
+	EXPECT_TRUE(map2.check_map_integrity());
+	EXPECT_EQ(map2.nb_cells<Vertex::ORBIT>(), 7u);
+	EXPECT_EQ(map2.nb_cells<Face::ORBIT>(), 5u);
+	EXPECT_EQ(map2.nb_boundaries(), 1u);
+}
+
 /**
  * \brief Cutting edges preserves the cell indexation
  */
@@ -229,6 +546,82 @@ TEST_F(CMap2Test, collapse_edge)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+/**
+ * \brief Cutting, flipping and collapsing sets of edges gives the same cells as the edge by edge operations
+ */
+TEST_F(CMap2Test, batch_edge_operations)
+{
+	add_closed_surfaces();
+
+	std::vector<Edge> edges;
+	uint32 count = 0u;
+	cmap_.foreach_cell([&] (Edge e) { if (count++ % 2u == 0u) edges.push_back(e); });
+	const uint32 nb_vertices = cmap_.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_edges = cmap_.nb_cells<Edge::ORBIT>();
+
+	std::vector<Vertex> vertices = cmap_.cut_edges(edges);
+	EXPECT_EQ(vertices.size(), edges.size());
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), nb_vertices + uint32(edges.size()));
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), nb_edges + uint32(edges.size()));
+	EXPECT_TRUE(cmap_.check_map_integrity());
+
+	cmap_.flip_edges(edges);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), nb_vertices + uint32(edges.size()));
+	EXPECT_TRUE(cmap_.check_map_integrity());
+
+	// a triangulated grid, on which interior edges that do not share a triangle are collapsed
+	const uint32 n = 12u;
+	std::vector<uint32> faces_nb_edges;
+	std::vector<uint32> faces_vertex_indices;
+	for (uint32 i = 0u; i < n - 1u; ++i)
+	{
+		for (uint32 j = 0u; j < n - 1u; ++j)
+		{
+			const uint32 a = i * n + j;
+			faces_vertex_indices.insert(faces_vertex_indices.end(), {a, a + 1u, a + n + 1u, a, a + n + 1u, a + n});
+			faces_nb_edges.insert(faces_nb_edges.end(), {3u, 3u});
+		}
+	}
+
+	CMap2 map[2];
+	std::vector<Edge> collapsed;
+	for (CMap2& m : map)
+	{
+		MapBuilder mbuild(m);
+		mbuild.create_embedding<Vertex::ORBIT>();
+		for (uint32 i = 0u; i < n * n; ++i)
+			mbuild.attribute_container<Vertex::ORBIT>().insert_lines<1>();
+		bool non_manifold = false;
+		mbuild.add_faces_bulk(faces_nb_edges, faces_vertex_indices, non_manifold);
+		mbuild.close_map();
+		m.add_attribute<int32, Edge>("edges");
+		m.add_attribute<int32, Face>("faces");
+	}
+
+	CMap2::CellMarker<Face::ORBIT> fm(map[0]);
+	map[0].foreach_cell([&] (Edge e)
+	{
+		const Dart d2 = map[0].phi2(e.dart);
+		if (map[0].edge_can_collapse(e) && !fm.is_marked(Face(e.dart)) && !fm.is_marked(Face(d2)))
+		{
+			fm.mark(Face(e.dart));
+			fm.mark(Face(d2));
+			collapsed.push_back(e);
+		}
+	});
+	EXPECT_GT(collapsed.size(), 1u);
+
+	for (Edge e : collapsed)
+		map[0].collapse_edge(e);
+	map[1].collapse_edges(collapsed);
+
+	EXPECT_TRUE(map[1].check_map_integrity());
+	EXPECT_EQ(map[1].nb_cells<Vertex::ORBIT>(), n * n - uint32(collapsed.size()));
+	EXPECT_EQ(map[1].nb_cells<Vertex::ORBIT>(), map[0].nb_cells<Vertex::ORBIT>());
+	EXPECT_EQ(map[1].nb_cells<Edge::ORBIT>(), map[0].nb_cells<Edge::ORBIT>());
+	EXPECT_EQ(map[1].nb_cells<Face::ORBIT>(), map[0].nb_cells<Face::ORBIT>());
+}
+
 /**
  * \brief Cutting faces preserves the cell indexation
  */
@@ -21,6 +21,8 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <atomic>
+
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap2.h>
@@ -714,6 +716,46 @@ TEST_F(CMap2TopoTest, nb_connected_components)
 	EXPECT_EQ(nb_connected_components(), 13u);
 }
 
+/**
+ * \brief The chunk scan parallel traversal visits each (non boundary) cell exactly once
+ * The test is done on non embedded then on embedded vertices.
+ */
+TEST_F(CMap2TopoTest, parallel_foreach_cell_chunk_scan)
+{
+	add_closed_surfaces();
+
+	std::atomic<uint32> nb_vertices(0u);
+	std::atomic<uint32> nb_vertex_darts(0u);
+	parallel_foreach_cell<FORCE_CHUNK_SCAN>([&] (Vertex v)
+	{
+		++nb_vertices;
+		nb_vertex_darts += degree(v);
+	});
+	EXPECT_EQ(nb_vertices, nb_cells<Vertex::ORBIT>());
+	EXPECT_EQ(nb_vertex_darts, nb_darts());
+
+	std::atomic<uint32> nb_faces(0u);
+	parallel_foreach_cell<FORCE_CHUNK_SCAN>([&] (Face)
+	{
+		++nb_faces;
+	},
+	[&] (Face f) { return codegree(f) > 3u; });
+	uint32 nb_filtered_faces = 0u;
+	foreach_cell([&] (Face f) { if (codegree(f) > 3u) ++nb_filtered_faces; });
+	EXPECT_EQ(nb_faces, nb_filtered_faces);
+
+	add_attribute<int32, Vertex::ORBIT>("vertices");
+	nb_vertices = 0u;
+	nb_vertex_darts = 0u;
+	parallel_foreach_cell<FORCE_CHUNK_SCAN>([&] (Vertex v)
+	{
+		++nb_vertices;
+		nb_vertex_darts += degree(v);
+	});
+	EXPECT_EQ(nb_vertices, nb_cells<Vertex::ORBIT>());
+	EXPECT_EQ(nb_vertex_darts, nb_darts());
+}
+
 #undef NB_MAX
 
 } // namespace cgogn
@@ -21,6 +21,8 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap2_tri.h>
@@ -263,4 +265,74 @@ TEST_F(CMap2TriTest, add_tetra)
 	});
 }
 
+/**
+ * @brief The compact map has the topology and the boundary of the standard map built in the same way
+ */
+TEST_F(CMap2TriTest, compact)
+{
+	CMap2TriCompact cmap;
+	CMap2TriCompact::Builder cbuilder(cmap);
+	MapBuilder builder(cmap_);
+
+	Dart d1 = builder.add_face_topo_fp(3u);
+	Dart d2 = builder.add_face_topo_fp(3u);
+	builder.phi2_sew(d1, d2);
+	builder.close_map();
+	Dart c1 = cbuilder.add_face_topo_fp(3u);
+	Dart c2 = cbuilder.add_face_topo_fp(3u);
+	cbuilder.phi2_sew(c1, c2);
+	cbuilder.close_map();
+
+	embed_map();
+	cmap.add_attribute<int32, CMap2TriCompact::Vertex>("vertices");
+	cmap.add_attribute<int32, CMap2TriCompact::Face>("faces");
+
+	auto same_maps = [&] () -> bool
+	{
+		bool same = cmap.nb_darts() == cmap_.nb_darts();
+		cmap_.foreach_dart([&] (Dart d)
+		{
+			same = same && cmap.phi2(d) == cmap_.phi2(d) && cmap.is_boundary(d) == cmap_.is_boundary(d);
+		});
+		return same;
+	};
+
+	EXPECT_TRUE(cmap.check_map_integrity());
+	EXPECT_TRUE(same_maps());
+	EXPECT_EQ(cmap.nb_cells<CMap2TriCompact::Vertex::ORBIT>(), 4u);
+	EXPECT_EQ(cmap.nb_cells<CMap2TriCompact::Edge::ORBIT>(), 5u);
+	EXPECT_EQ(cmap.nb_cells<CMap2TriCompact::Face::ORBIT>(), 2u);
+
+	cmap_.flip_edge(Edge(d1));
+	cmap.flip_edge(CMap2TriCompact::Edge(c1));
+	cmap_.cut_edge(Edge(d1));
+	cmap.cut_edge(CMap2TriCompact::Edge(c1));
+	EXPECT_TRUE(cmap.check_map_integrity());
+	EXPECT_TRUE(same_maps());
+
+	// the boundary flags packed with phi2 follow the darts when they are moved
+	uint32 nb_boundary = 0u;
+	std::vector<Dart> order;
+	cmap.foreach_dart([&] (Dart d)
+	{
+		order.push_back(d);
+		if (cmap.is_boundary(d))
+			++nb_boundary;
+	});
+	std::reverse(order.begin(), order.end());
+	EXPECT_TRUE(cmap.reorder_darts(order));
+	EXPECT_TRUE(cmap.check_map_integrity());
+	uint32 nb_boundary_after = 0u;
+	cmap.foreach_dart([&] (Dart d)
+	{
+		if (cmap.is_boundary(d))
+		{
+			++nb_boundary_after;
+			EXPECT_TRUE(cmap.is_boundary(cmap.phi1(d)));
+		}
+	});
+	EXPECT_EQ(nb_boundary_after, nb_boundary);
+	EXPECT_EQ(cmap.nb_cells<CMap2TriCompact::Face::ORBIT>(), 4u);
+}
+
 } // namespace cgogn
@@ -201,4 +201,40 @@ TEST_F(CMap3TetraTest, embedded)
 	EXPECT_EQ(nb,4);
 }
 
+/**
+ * @brief The compact map has the topology and the boundary of the standard map built in the same way
+ */
+TEST_F(CMap3TetraTest, compact)
+{
+	CMap3TetraCompact cmap;
+	CMap3TetraCompact::Builder cbuild(cmap);
+	MapBuilder mbuild(cmap_);
+
+	Dart p1 = mbuild.add_pyramid_topo_fp(3u);
+	Dart p2 = mbuild.add_pyramid_topo_fp(3u);
+	mbuild.sew_volumes_fp(p1, p2);
+	mbuild.close_map();
+	Dart c1 = cbuild.add_pyramid_topo_fp(3u);
+	Dart c2 = cbuild.add_pyramid_topo_fp(3u);
+	cbuild.sew_volumes_fp(c1, c2);
+	cbuild.close_map();
+
+	EXPECT_TRUE(cmap.check_map_integrity());
+	EXPECT_EQ(cmap.nb_darts(), cmap_.nb_darts());
+	uint32 nb_boundary = 0u;
+	cmap_.foreach_dart([&] (Dart d)
+	{
+		EXPECT_EQ(cmap.phi3(d), cmap_.phi3(d));
+		EXPECT_EQ(cmap.is_boundary(d), cmap_.is_boundary(d));
+		if (cmap.is_boundary(d))
+			++nb_boundary;
+	});
+	EXPECT_GT(nb_boundary, 0u);
+
+	EXPECT_EQ(cmap.nb_cells<CMap3TetraCompact::Vertex::ORBIT>(), 5u);
+	EXPECT_EQ(cmap.nb_cells<CMap3TetraCompact::Edge::ORBIT>(), 9u);
+	EXPECT_EQ(cmap.nb_cells<CMap3TetraCompact::Face::ORBIT>(), 7u);
+	EXPECT_EQ(cmap.nb_cells<CMap3TetraCompact::Volume::ORBIT>(), 2u);
+}
+
 } // namespace cgogn
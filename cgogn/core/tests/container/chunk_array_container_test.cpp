@@ -23,6 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
 #include <cgogn/core/container/chunk_array_container.h>
 
 namespace cgogn
@@ -139,6 +143,475 @@ TEST_F(ChunkArrayContainerTest, test_compact)
 
 }
 
+TEST_F(ChunkArrayContainerTest, test_parallel_reduce_index)
+{
+	using DATA = uint32;
+	ChunkArrayContainer ca_cont;
+	ChunkArray<DATA>* values = ca_cont.add_chunk_array<DATA>("values");
+
+	for (uint32 i = 0; i < 100; ++i)
+	{
+		ca_cont.insert_lines<1>();
+		values->operator[](i) = i;
+	}
+	for (uint32 i = 0; i < 100; i += 3)
+		ca_cont.remove_lines<1>(i);
+
+	uint32 sum = 0u;
+	std::vector<uint32> used_indices;
+	for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+	{
+		sum += values->operator[](i);
+		used_indices.push_back(i);
+	}
+
+	const uint32 reduced_sum = ca_cont.parallel_reduce_index(0u,
+		[&] (uint32 i) { return values->operator[](i); },
+		[] (uint32 a, uint32 b) { return a + b; });
+	EXPECT_EQ(reduced_sum, sum);
+
+	const uint32 reduced_max = ca_cont.parallel_reduce_index(0u,
+		[&] (uint32 i) { return values->operator[](i); },
+		[] (uint32 a, uint32 b) { return std::max(a, b); });
+	EXPECT_EQ(reduced_max, 98u);
+
+	// the partials are combined in index order
+	const std::vector<uint32> concatenation = ca_cont.parallel_reduce_index(std::vector<uint32>(),
+		[] (uint32 i) { return std::vector<uint32>(1u, i); },
+		[] (std::vector<uint32> a, const std::vector<uint32>& b) { a.insert(a.end(), b.begin(), b.end()); return a; });
+	EXPECT_EQ(concatenation, used_indices);
+}
+
+TEST_F(ChunkArrayContainerTest, test_foreach_chunk)
+{
+	using DATA = uint32;
+	using ChunkMask = ChunkArrayContainer::ChunkMask;
+	ChunkArrayContainer ca_cont;
+	ChunkArray<DATA>* values = ca_cont.add_chunk_array<DATA>("values");
+
+	for (uint32 i = 0; i < 40; ++i)
+	{
+		ca_cont.insert_lines<1>();
+		values->operator[](i) = i;
+	}
+	for (uint32 i = 16; i < 32; ++i)
+		ca_cont.remove_lines<1>(i);
+	ca_cont.remove_lines<1>(3);
+
+	EXPECT_EQ(ca_cont.nb_chunks(), 3u);
+
+	ChunkMask mask;
+	EXPECT_EQ(ca_cont.chunk_mask(0u, mask), 15u);
+	EXPECT_EQ(mask[0], uint64(0xFFF7u));
+	EXPECT_EQ(ca_cont.chunk_mask(1u, mask), 0u);
+	EXPECT_EQ(ca_cont.chunk_mask(2u, mask), 8u);
+	EXPECT_EQ(mask[0], uint64(0x00FFu));
+
+	std::vector<uint32> chunks;
+	ca_cont.foreach_chunk([&] (uint32 chunk, const ChunkMask&) { chunks.push_back(chunk); });
+	EXPECT_EQ(chunks, std::vector<uint32>({0u, 2u}));
+
+	ca_cont.parallel_foreach_chunk([&] (uint32 chunk, const ChunkMask& m)
+	{
+		DATA* data = values->chunk_data(chunk);
+		foreach_chunk_line(m, [&] (uint32 i) { data[i] *= 2u; });
+	});
+
+	for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+		EXPECT_EQ(values->operator[](i), 2u * i);
+}
+
+TEST_F(ChunkArrayContainerTest, test_soa_array)
+{
+	using DATA = std::array<float64, 3>;
+	using ChunkArraySoA = ChunkArrayContainer::ChunkArraySoA<DATA>;
+	ChunkArrayContainer ca_cont;
+	ChunkArraySoA* soa = ca_cont.add_chunk_array_soa<DATA>("soa");
+	ChunkArray<DATA>* aos = ca_cont.add_chunk_array<DATA>("aos");
+
+	EXPECT_EQ(ca_cont.get_chunk_array_soa<DATA>("soa"), soa);
+	EXPECT_EQ(ca_cont.get_chunk_array<DATA>("soa"), nullptr);
+	EXPECT_EQ(ca_cont.get_chunk_array_soa<DATA>("aos"), nullptr);
+	EXPECT_TRUE(soa->soa_layout());
+	EXPECT_FALSE(aos->soa_layout());
+
+	for (uint32 i = 0; i < 40; ++i)
+	{
+		ca_cont.insert_lines<1>();
+		soa->operator[](i) = DATA({{float64(i), 2.0 * i, 3.0 * i}});
+	}
+	EXPECT_EQ(soa->nb_chunks(), 3u);
+	EXPECT_EQ(soa->nb_components(), 3u);
+
+	// components are stored in separate chunks
+	EXPECT_EQ(soa->chunk_data(1u, 0u)[2], 18.0);
+	EXPECT_EQ(soa->chunk_data(1u, 1u)[2], 36.0);
+	EXPECT_EQ(soa->chunk_data(1u, 2u)[2], 54.0);
+	uint32 byte_chunk_size;
+	EXPECT_EQ(soa->chunks_pointers(byte_chunk_size).size(), 9u);
+	EXPECT_EQ(byte_chunk_size, 16u * sizeof(float64));
+
+	// proxy access
+	soa->operator[](5u) += DATA({{1.0, 1.0, 1.0}});
+	soa->operator[](5u)[2] = 0.0;
+	const DATA v = soa->operator[](5u);
+	EXPECT_EQ(v, DATA({{6.0, 11.0, 0.0}}));
+	soa->operator[](6u) = soa->operator[](5u);
+	EXPECT_EQ(DATA(soa->operator[](6u)), v);
+
+	// generic container operations go through the virtual interface
+	ca_cont.remove_lines<1>(3u);
+	ca_cont.remove_lines<1>(37u);
+	ca_cont.compact<1>();
+	for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+	{
+		const DATA d = soa->operator[](i);
+		EXPECT_EQ(d[1], (i == 5u || i == 6u) ? 11.0 : 2.0 * d[0]);
+	}
+}
+
+TEST_F(ChunkArrayContainerTest, test_chunk_allocator)
+{
+	using DATA = std::array<float64, 3>;
+	const std::array<cgogn::ChunkAllocationMode, 4> modes = {{
+		cgogn::ChunkAllocationMode::DEFAULT,
+		cgogn::ChunkAllocationMode::HUGE_PAGES,
+		cgogn::ChunkAllocationMode::FIRST_TOUCH,
+		cgogn::ChunkAllocationMode::INTERLEAVED
+	}};
+
+	for (cgogn::ChunkAllocationMode mode : modes)
+	{
+		ChunkArrayContainer ca_cont;
+		EXPECT_TRUE(ca_cont.set_chunk_allocator(cgogn::ChunkAllocator(mode, false)));
+		ChunkArray<uint32>* indices = ca_cont.add_chunk_array<uint32>("indices");
+		ChunkArray<DATA>* vecs = ca_cont.add_chunk_array<DATA>("vecs");
+		EXPECT_EQ(indices->chunk_allocator(), cgogn::ChunkAllocator(mode, false));
+		EXPECT_EQ(vecs->chunk_allocator(), cgogn::ChunkAllocator(mode, false));
+
+		for (uint32 i = 0u; i < 100u; ++i)
+		{
+			const uint32 l = ca_cont.insert_lines<1>();
+			(*indices)[l] = l;
+			(*vecs)[l] = DATA({{float64(l), 0.0, 1.0}});
+		}
+		// the allocator cannot be changed once the container has chunks
+		EXPECT_FALSE(ca_cont.set_chunk_allocator(cgogn::ChunkAllocator()));
+		// refs are value-initialized whatever the allocator : unused lines of the last chunk are seen as such
+		EXPECT_EQ(ca_cont.size(), 100u);
+		uint32 nb = 0u;
+		for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+			++nb;
+		EXPECT_EQ(nb, 100u);
+
+		// arrays created after the allocator and grown by several chunks at once
+		ChunkArray<float32>* values = ca_cont.add_chunk_array<float32>("values");
+		EXPECT_EQ(values->chunk_allocator(), cgogn::ChunkAllocator(mode, false));
+		for (uint32 i = 0u; i < 100u; ++i)
+			(*values)[i] = float32(i);
+
+		ca_cont.remove_lines<1>(50u);
+		ca_cont.compact<1>();
+		for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+		{
+			EXPECT_EQ((*vecs)[i][0], float64((*indices)[i]));
+			EXPECT_EQ((*values)[i], float32((*indices)[i]));
+		}
+		if (mode != cgogn::ChunkAllocationMode::DEFAULT)
+		{
+			EXPECT_EQ(reinterpret_cast<std::size_t>(vecs->chunk_data(0u)) % cgogn::ChunkAllocator::page_size(), 0u);
+		}
+	}
+}
+
+TEST_F(ChunkArrayContainerTest, test_save_load_mapped)
+{
+	if (!cgogn::MappedFile::is_supported())
+		return;
+
+	const std::string filename("cgogn_chunk_array_container_test.map");
+	const uint32 alignment = uint32(cgogn::ChunkAllocator::page_size());
+	{
+		ChunkArrayContainer ca_cont;
+		ChunkArray<float32>* values = ca_cont.add_chunk_array<float32>("values");
+		ChunkArray<std::string>* names = ca_cont.add_chunk_array<std::string>("names");
+		for (uint32 i = 0u; i < 100u; ++i)
+		{
+			const uint32 l = ca_cont.insert_lines<1>();
+			(*values)[l] = float32(l);
+			(*names)[l] = std::to_string(l);
+		}
+		ca_cont.remove_lines<1>(10u);
+		ca_cont.remove_lines<1>(20u);
+		std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+		ca_cont.save_mapped(ofs, alignment);
+	}
+
+	std::shared_ptr<cgogn::MappedFile> file = std::make_shared<cgogn::MappedFile>();
+	ASSERT_TRUE(file->open(filename));
+	std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+
+	ChunkArrayContainer ca_cont;
+	ChunkArray<float32>* values = ca_cont.add_chunk_array<float32>("values");
+	EXPECT_TRUE(ca_cont.load_mapped(ifs, file, alignment));
+	// the existing array is reused and its chunks point into the mapping
+	EXPECT_EQ(ca_cont.get_chunk_array<float32>("values"), values);
+	EXPECT_EQ(values->nb_chunks(), 7u);
+	EXPECT_EQ(values->nb_mapped_chunks(), 7u);
+	EXPECT_EQ(reinterpret_cast<std::size_t>(values->chunk_data(0u)) % alignment, 0u);
+	// non mappable data is streamed
+	ChunkArray<std::string>* names = ca_cont.get_chunk_array<std::string>("names");
+	ASSERT_NE(names, nullptr);
+	EXPECT_EQ(names->nb_mapped_chunks(), 0u);
+
+	EXPECT_EQ(ca_cont.size(), 98u);
+	for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+	{
+		EXPECT_EQ((*values)[i], float32(i));
+		EXPECT_EQ((*names)[i], std::to_string(i));
+	}
+
+	// the mapping stays alive as long as the arrays use it
+	file.reset();
+	std::remove(filename.c_str());
+
+	// holes are restored, written data is copied on write, new chunks are allocated
+	EXPECT_EQ(ca_cont.insert_lines<1>(), 20u);
+	EXPECT_EQ(ca_cont.insert_lines<1>(), 10u);
+	(*values)[0u] = -1.0f;
+	for (uint32 i = 0u; i < 20u; ++i)
+		(*values)[ca_cont.insert_lines<1>()] = 1.0f;
+	EXPECT_EQ(values->nb_chunks(), 8u);
+	EXPECT_EQ(values->nb_mapped_chunks(), 7u);
+	EXPECT_EQ((*values)[0u], -1.0f);
+	EXPECT_EQ((*values)[1u], 1.0f);
+	EXPECT_EQ((*values)[119u], 1.0f);
+
+	ca_cont.clear_chunk_arrays();
+	EXPECT_EQ(values->nb_mapped_chunks(), 0u);
+}
+
+TEST_F(ChunkArrayContainerTest, test_delta)
+{
+	ChunkArrayContainer ca_cont;
+	ChunkArray<float32>* values = ca_cont.add_chunk_array<float32>("values");
+	ChunkArray<std::string>* names = ca_cont.add_chunk_array<std::string>("names");
+	ca_cont.add_chunk_array<uint32>("removed");
+	for (uint32 i = 0u; i < 100u; ++i)
+	{
+		const uint32 l = ca_cont.insert_lines<1>();
+		(*values)[l] = float32(l);
+		(*names)[l] = std::to_string(l);
+	}
+
+	// copy of the container at the beginning of the tracking
+	ChunkArrayContainer ca_copy;
+	{
+		std::stringstream ss;
+		ca_cont.save(ss);
+		EXPECT_TRUE(ca_copy.load(ss));
+	}
+	ChunkArray<float32>* copy_values = ca_copy.get_chunk_array<float32>("values");
+	ASSERT_NE(copy_values, nullptr);
+
+	ca_cont.set_dirty_tracking(true);
+	EXPECT_EQ(values->nb_dirty_chunks(), 0u);
+
+	(*values)[5u] = -5.0f;
+	(*values)[50u] = -50.0f;
+	ca_cont.remove_lines<1>(30u);
+	for (uint32 i = 0u; i < 20u; ++i)
+		(*values)[ca_cont.insert_lines<1>()] = 1.0f;
+	ca_cont.remove_lines<1>(60u);
+	ca_cont.remove_chunk_array("removed");
+	ChunkArray<uint32>* added = ca_cont.add_chunk_array<uint32>("added");
+	added->set_all_values(7u);
+
+	// lines 5, 30 (reused hole) and 50 are written, chunks 6 and 7 are filled by the new lines
+	EXPECT_EQ(values->nb_chunks(), 8u);
+	EXPECT_EQ(values->nb_dirty_chunks(), 5u);
+	EXPECT_TRUE(values->is_dirty(0u) && values->is_dirty(1u) && values->is_dirty(3u) && values->is_dirty(6u) && values->is_dirty(7u));
+	EXPECT_FALSE(values->is_dirty(2u) || values->is_dirty(4u) || values->is_dirty(5u));
+	// only the new chunk
+	EXPECT_EQ(names->nb_dirty_chunks(), 1u);
+
+	std::stringstream ss;
+	ca_cont.save_delta(ss);
+	EXPECT_EQ(values->nb_dirty_chunks(), 0u);
+	EXPECT_EQ(added->nb_dirty_chunks(), 0u);
+
+	EXPECT_TRUE(ca_copy.apply_delta(ss));
+	// the existing arrays are kept
+	EXPECT_EQ(ca_copy.get_chunk_array<float32>("values"), copy_values);
+	EXPECT_FALSE(ca_copy.has_array("removed"));
+	ChunkArray<uint32>* copy_added = ca_copy.get_chunk_array<uint32>("added");
+	ChunkArray<std::string>* copy_names = ca_copy.get_chunk_array<std::string>("names");
+	ASSERT_NE(copy_added, nullptr);
+	ASSERT_NE(copy_names, nullptr);
+
+	EXPECT_EQ(ca_copy.size(), ca_cont.size());
+	EXPECT_EQ(ca_copy.end(), ca_cont.end());
+	// (read only access does not mark the chunks)
+	const ChunkArray<float32>& const_values = *values;
+	const ChunkArray<std::string>& const_names = *names;
+	for (uint32 i = ca_cont.begin(), j = ca_copy.begin(); i != ca_cont.end(); ca_cont.next(i), ca_copy.next(j))
+	{
+		EXPECT_EQ(i, j);
+		EXPECT_EQ((*copy_values)[i], const_values[i]);
+		EXPECT_EQ((*copy_names)[i], const_names[i]);
+		EXPECT_EQ((*copy_added)[i], 7u);
+	}
+	// the holes are restored
+	EXPECT_EQ(ca_copy.insert_lines<1>(), ca_cont.insert_lines<1>());
+
+	// an empty delta only contains the headers and the holes
+	std::stringstream empty;
+	ca_cont.save_delta(empty);
+	EXPECT_LT(empty.str().size(), ss.str().size() / 2u);
+	EXPECT_TRUE(ca_copy.apply_delta(empty));
+	EXPECT_EQ(ca_copy.size(), ca_cont.size());
+}
+
+TEST_F(ChunkArrayContainerTest, test_concurrent_insertions)
+{
+	ChunkArrayContainer ca_cont;
+	ChunkArray<uint32>* values = ca_cont.add_chunk_array<uint32>("values");
+	for (uint32 i = 0u; i < 100u; ++i)
+		ca_cont.insert_lines<1>();
+	for (uint32 i = 0u; i < 100u; i += 10u)
+		ca_cont.remove_lines<1>(i);
+
+	const uint32 nb_tasks = 8u;
+	std::vector<std::vector<uint32>> inserted(nb_tasks);
+	std::vector<std::future<void>> futures;
+	ca_cont.begin_concurrent_insertions<1>(2000u);
+	EXPECT_TRUE(ca_cont.concurrent_mode());
+	for (uint32 t = 0u; t < nb_tasks; ++t)
+	{
+		futures.push_back(cgogn::thread_pool()->enqueue([&ca_cont, &inserted, values, t] ()
+		{
+			std::vector<uint32>& lines = inserted[t];
+			for (uint32 i = 0u; i < 200u; ++i)
+			{
+				const uint32 l = ca_cont.insert_lines_concurrent<1>();
+				ASSERT_NE(l, uint32(ChunkArrayContainer::UNKNOWN));
+				(*values)[l] = t;
+				lines.push_back(l);
+			}
+			// the removed lines are reused by the thread
+			for (uint32 i = 0u; i < 150u; ++i)
+				ca_cont.remove_lines_concurrent<1>(lines[i]);
+			lines.erase(lines.begin(), lines.begin() + 150u);
+			for (uint32 i = 0u; i < 50u; ++i)
+			{
+				const uint32 l = ca_cont.insert_lines_concurrent<1>();
+				(*values)[l] = t;
+				lines.push_back(l);
+			}
+		}));
+	}
+	for (auto& f : futures)
+		f.wait();
+	ca_cont.end_concurrent_insertions<1>();
+	EXPECT_FALSE(ca_cont.concurrent_mode());
+
+	EXPECT_EQ(ca_cont.size(), 90u + nb_tasks * 100u);
+	std::vector<uint32> owner(ca_cont.end(), uint32(ChunkArrayContainer::UNKNOWN));
+	for (uint32 t = 0u; t < nb_tasks; ++t)
+	{
+		for (uint32 l : inserted[t])
+		{
+			EXPECT_TRUE(ca_cont.used(l));
+			EXPECT_EQ(owner[l], uint32(ChunkArrayContainer::UNKNOWN));
+			EXPECT_EQ((*values)[l], t);
+			owner[l] = t;
+		}
+	}
+	uint32 nb = 0u;
+	for (uint32 i = ca_cont.begin(); i != ca_cont.end(); ca_cont.next(i))
+		++nb;
+	EXPECT_EQ(nb, ca_cont.size());
+
+	// the unused lines are holes for the sequential insertions
+	const uint32 end = ca_cont.end();
+	while (ca_cont.size() < end)
+		EXPECT_LT(ca_cont.insert_lines<1>(), end);
+	EXPECT_EQ(ca_cont.insert_lines<1>(), end);
+}
+
+TEST_F(ChunkArrayContainerTest, test_concurrent_refs)
+{
+	ChunkArrayContainer ca_cont;
+	for (uint32 i = 0u; i < 10u; ++i)
+		ca_cont.insert_lines<1>();
+	for (uint32 i = 0u; i < 10u; ++i)
+	{
+		ca_cont.ref_line(i); // 2 references per line (a line is removed when its counter is back to 1)
+		ca_cont.ref_line(i);
+	}
+
+	const uint32 nb_tasks = 4u;
+	std::vector<std::future<void>> futures;
+	ca_cont.begin_concurrent_insertions<1>(100u);
+	for (uint32 t = 0u; t < nb_tasks; ++t)
+	{
+		futures.push_back(cgogn::thread_pool()->enqueue([&ca_cont, t] ()
+		{
+			// the updates are deferred and the refs are applied first:
+			// a line that is unreferenced then referenced is not removed
+			EXPECT_FALSE(ca_cont.unref_line(t));
+			EXPECT_FALSE(ca_cont.unref_line(t));
+			ca_cont.ref_line(t);
+			EXPECT_FALSE(ca_cont.unref_line(4u + t));
+			EXPECT_FALSE(ca_cont.unref_line(8u + t % 2u));
+		}));
+	}
+	for (auto& f : futures)
+		f.wait();
+	EXPECT_EQ(ca_cont.size(), 10u);
+	ca_cont.end_concurrent_insertions<1>();
+
+	// lines 0-3: 2-2+1 references, lines 4-7: 2-1, lines 8-9: 2-2 (removed)
+	EXPECT_EQ(ca_cont.size(), 8u);
+	for (uint32 i = 0u; i < 8u; ++i)
+		EXPECT_TRUE(ca_cont.used(i));
+	EXPECT_FALSE(ca_cont.used(8u));
+	EXPECT_FALSE(ca_cont.used(9u));
+}
+
+TEST_F(ChunkArrayContainerTest, test_reorder)
+{
+	ChunkArrayContainer ca_cont;
+	ChunkArray<uint32>* values = ca_cont.add_chunk_array<uint32>("values");
+	for (uint32 i = 0u; i < 50u; ++i)
+		(*values)[ca_cont.insert_lines<1>()] = i;
+	for (uint32 i = 0u; i < 50u; i += 7u)
+		ca_cont.remove_lines<1>(i);
+	const uint32 nb = ca_cont.size();
+
+	// not a permutation of the used lines
+	EXPECT_TRUE(ca_cont.reorder<1>(std::vector<uint32>(nb, 1u)).empty());
+	EXPECT_TRUE(ca_cont.reorder<1>(std::vector<uint32>{1u, 2u}).empty());
+	EXPECT_EQ(ca_cont.end(), 50u);
+
+	std::vector<uint32> order;
+	for (uint32 i = ca_cont.rbegin(); i != ca_cont.rend(); ca_cont.rnext(i))
+		order.push_back(i);
+	const std::vector<uint32> old_new = ca_cont.reorder<1>(order);
+	ASSERT_EQ(old_new.size(), 50u);
+
+	EXPECT_EQ(ca_cont.size(), nb);
+	EXPECT_EQ(ca_cont.end(), nb);
+	for (uint32 i = 0u; i < nb; ++i)
+	{
+		EXPECT_TRUE(ca_cont.used(i));
+		EXPECT_EQ((*values)[i], order[i]);
+		EXPECT_EQ(old_new[order[i]], i);
+	}
+	EXPECT_EQ(old_new[0u], std::numeric_limits<uint32>::max());
+	EXPECT_EQ(ca_cont.insert_lines<1>(), nb);
+}
+
 TEST_F(ChunkArrayContainerTest, test_compact_tri)
 {
 	using DATA = uint32;
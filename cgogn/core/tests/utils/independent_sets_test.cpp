@@ -0,0 +1,158 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/utils/independent_sets.h>
+
+namespace cgogn
+{
+
+/**
+ * \brief The IndependentSetsTest class builds a closed triangulated surface (a grid whose border is closed
+ * by a boundary face) on which the independent sets and the concurrent local operations are tested.
+ */
+class IndependentSetsTest : public ::testing::Test
+{
+public:
+
+	using MapBuilder = CMap2::Builder;
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+	using Face = CMap2::Face;
+
+protected:
+
+	CMap2 map_;
+	std::vector<Edge> edges_;
+
+	IndependentSetsTest()
+	{
+		const uint32 n = 16u;
+		std::vector<uint32> faces_nb_edges;
+		std::vector<uint32> faces_vertex_indices;
+		for (uint32 i = 0u; i < n - 1u; ++i)
+		{
+			for (uint32 j = 0u; j < n - 1u; ++j)
+			{
+				const uint32 a = i * n + j;
+				faces_vertex_indices.insert(faces_vertex_indices.end(), {a, a + 1u, a + n + 1u, a, a + n + 1u, a + n});
+				faces_nb_edges.insert(faces_nb_edges.end(), {3u, 3u});
+			}
+		}
+
+		MapBuilder mbuild(map_);
+		mbuild.create_embedding<Vertex::ORBIT>();
+		for (uint32 i = 0u; i < n * n; ++i)
+			mbuild.attribute_container<Vertex::ORBIT>().insert_lines<1>();
+		bool non_manifold = false;
+		mbuild.add_faces_bulk(faces_nb_edges, faces_vertex_indices, non_manifold);
+		mbuild.close_map();
+		map_.add_attribute<int32, Edge>("edges");
+		map_.add_attribute<int32, Face>("faces");
+
+		map_.foreach_cell([&] (Edge e) { edges_.push_back(e); });
+	}
+
+	/**
+	 * \brief Check that the neighbourhoods of the cells of each set do not overlap
+	 */
+	void check_sets(uint32 radius)
+	{
+		IndependentSetScheduler<CMap2> scheduler(map_, radius);
+		std::vector<uint32> nb_visits(edges_.size(), 0u);
+		std::vector<uint32> owner(map_.topology_container().end());
+		uint32 nb_sets = 0u;
+		scheduler.foreach_independent_set(edges_, [&] (const std::vector<uint32>& set)
+		{
+			std::fill(owner.begin(), owner.end(), INVALID_INDEX);
+			for (uint32 i : set)
+			{
+				++nb_visits[i];
+				scheduler.foreach_dart_of_neighbourhood(edges_[i], [&] (Dart d)
+				{
+					EXPECT_EQ(owner[d.index], INVALID_INDEX);
+					owner[d.index] = i;
+				});
+			}
+			++nb_sets;
+		});
+		EXPECT_EQ(nb_sets, scheduler.nb_sets());
+		EXPECT_GT(nb_sets, 1u);
+		EXPECT_LT(nb_sets, uint32(edges_.size()));
+		for (uint32 n : nb_visits)
+			EXPECT_EQ(n, 1u);
+	}
+};
+
+/**
+ * \brief The neighbourhoods of the cells of an independent set are disjoint
+ * and each cell belongs to exactly one set
+ */
+TEST_F(IndependentSetsTest, independent_sets)
+{
+	check_sets(0u);
+	check_sets(1u);
+	check_sets(2u);
+}
+
+/**
+ * \brief Cutting and flipping edges concurrently gives a valid map with the same numbers of cells
+ * as the sequential operations
+ */
+TEST_F(IndependentSetsTest, parallel_foreach_cell)
+{
+	const uint32 nb_vertices = map_.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_edges = map_.nb_cells<Edge::ORBIT>();
+	const uint32 nb_faces = map_.nb_cells<Face::ORBIT>();
+
+	IndependentSetScheduler<CMap2> scheduler(map_, 0u);
+	std::vector<Vertex> vertices(map_.topology_container().end());
+	scheduler.parallel_foreach_cell(edges_, [&] (Edge e)
+	{
+		EXPECT_TRUE(map_.concurrent_editing());
+		vertices[e.dart.index] = map_.cut_edge(e);
+	}, 2u, 1u);
+	EXPECT_FALSE(map_.concurrent_editing());
+
+	EXPECT_TRUE(map_.check_map_integrity());
+	EXPECT_EQ(map_.nb_cells<Vertex::ORBIT>(), nb_vertices + nb_edges);
+	EXPECT_EQ(map_.nb_cells<Edge::ORBIT>(), 2u * nb_edges);
+	EXPECT_EQ(map_.nb_cells<Face::ORBIT>(), nb_faces);
+	for (Edge e : edges_)
+		EXPECT_EQ(map_.degree(vertices[e.dart.index]), 2u);
+
+	std::vector<Edge> interior_edges;
+	for (Edge e : edges_)
+		if (!map_.is_incident_to_boundary(e))
+			interior_edges.push_back(e);
+	scheduler.parallel_foreach_cell(interior_edges, [&] (Edge e) { map_.flip_edge(e); }, 0u, 0u);
+
+	EXPECT_TRUE(map_.check_map_integrity());
+	EXPECT_EQ(map_.nb_cells<Vertex::ORBIT>(), nb_vertices + nb_edges);
+	EXPECT_EQ(map_.nb_cells<Edge::ORBIT>(), 2u * nb_edges);
+	EXPECT_EQ(map_.nb_cells<Face::ORBIT>(), nb_faces);
+}
+
+} // namespace cgogn
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+
+#include <cgogn/core/utils/thread_pool.h>
+
+TEST(ThreadPoolTest, enqueue_futures)
+{
+	cgogn::ThreadPool* tp = cgogn::thread_pool();
+	std::atomic<uint32_t> counter(0u);
+
+	std::vector<std::future<void>> futures;
+	for (uint32_t i = 0u; i < 1000u; ++i)
+		futures.push_back(tp->enqueue([&counter] () { ++counter; }));
+	for (auto& f : futures)
+		f.wait();
+
+	EXPECT_EQ(counter.load(), 1000u);
+}
+
+TEST(ThreadPoolTest, enqueue_task_group)
+{
+	cgogn::ThreadPool* tp = cgogn::thread_pool();
+	std::atomic<uint32_t> counter(0u);
+	std::vector<uint32_t> per_thread(tp->max_nb_workers(), 0u);
+
+	cgogn::TaskGroup group;
+	for (uint32_t i = 0u; i < 1000u; ++i)
+		tp->enqueue(group, [&counter, &per_thread] ()
+		{
+			++counter;
+			++per_thread[cgogn::current_thread_index()];
+		});
+	group.wait();
+
+	uint32_t total = 0u;
+	for (uint32_t n : per_thread)
+		total += n;
+
+	EXPECT_EQ(counter.load(), 1000u);
+	EXPECT_EQ(total, 1000u);
+}
+
+TEST(ThreadPoolTest, enqueue_from_worker)
+{
+	cgogn::ThreadPool* tp = cgogn::thread_pool();
+	std::atomic<uint32_t> counter(0u);
+
+	cgogn::TaskGroup group;
+	for (uint32_t i = 0u; i < 16u; ++i)
+		tp->enqueue(group, [tp, &group, &counter] ()
+		{
+			for (uint32_t j = 0u; j < 16u; ++j)
+				tp->enqueue(group, [&counter] () { ++counter; });
+		});
+	group.wait();
+
+	EXPECT_EQ(counter.load(), 256u);
+}
+
+TEST(ThreadPoolTest, thread_task)
+{
+	uint32_t small_result = 0u;
+	cgogn::ThreadTask small([&small_result] () { small_result = 1u; });
+	cgogn::ThreadTask moved(std::move(small));
+	EXPECT_FALSE(small.is_valid());
+	EXPECT_TRUE(moved.is_valid());
+	moved();
+	EXPECT_EQ(small_result, 1u);
+
+	// callable too large to be stored inline
+	std::array<uint32_t, 64> big;
+	big.fill(2u);
+	uint32_t big_result = 0u;
+	cgogn::ThreadTask large([big, &big_result] () { big_result = big[63]; });
+	cgogn::ThreadTask large_moved;
+	large_moved = std::move(large);
+	large_moved();
+	EXPECT_EQ(big_result, 2u);
+}
@@ -0,0 +1,233 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_INDEPENDENT_SETS_H_
+#define CGOGN_CORE_UTILS_INDEPENDENT_SETS_H_
+
+#include <type_traits>
+#include <vector>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/definitions.h>
+#include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/dart.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief Scheduler of local operations on the cells of a map, that runs concurrently the operations
+ * whose neighbourhoods do not overlap.
+ * The neighbourhood of radius 0 of a cell is made of the top cells (faces of a 2-map, volumes of a 3-map)
+ * incident to the cell. The neighbourhood of radius 1 is made of the top cells incident to the vertices
+ * of the cell, and the neighbourhood of radius r > 1 of the top cells incident to the vertices of the
+ * neighbourhood of radius r-1. An operation must only read and write the darts of the neighbourhood of its cell.
+ * The cells are split into independent sets with a greedy colouring: a set takes, in order, each remaining cell
+ * whose neighbourhood does not overlap the neighbourhoods of the cells already in the set. Each set is computed
+ * on the current topology just after the operations of the previous set, since an operation can extend
+ * the neighbourhoods of the remaining cells (e.g. an edge collapse merges two vertex stars).
+ */
+template <typename MAP>
+class IndependentSetScheduler
+{
+public:
+
+	using Self = IndependentSetScheduler<MAP>;
+	using Vertex = typename MAP::Vertex;
+	using TopCell = typename std::conditional<MAP::DIMENSION == 2u, typename MAP::Face, typename MAP::Volume>::type;
+	using DartMarkerEpoch = typename MAP::DartMarkerEpoch;
+
+	static_assert(MAP::DIMENSION == 2u || MAP::DIMENSION == 3u, "IndependentSetScheduler: 2-maps and 3-maps only");
+
+	/**
+	 * @param map the map whose cells are scheduled
+	 * @param radius radius of the neighbourhood of the cells touched by the operations
+	 */
+	inline IndependentSetScheduler(MAP& map, uint32 radius) :
+		map_(map),
+		radius_(radius),
+		nb_sets_(0u),
+		in_set_(map),
+		visited_top_cell_(map),
+		visited_vertex_(map)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(IndependentSetScheduler);
+
+	/**
+	 * @brief number of sets computed by the last call to foreach_independent_set or parallel_foreach_cell
+	 */
+	inline uint32 nb_sets() const
+	{
+		return nb_sets_;
+	}
+
+	/**
+	 * @brief apply a function on the darts of the neighbourhood of a cell
+	 */
+	template <typename CellType, typename FUNC>
+	void foreach_dart_of_neighbourhood(CellType c, const FUNC& func)
+	{
+		static_assert(is_func_parameter_same<FUNC, Dart>::value, "Wrong function parameter type");
+
+		compute_neighbourhood(c);
+		for (Dart d : neighbourhood_)
+			func(d);
+	}
+
+	/**
+	 * @brief split the cells into independent sets and call a function on each set
+	 * @param cells the cells (they must be distinct)
+	 * @param func function called on each set with the indices (in cells) of the cells of the set;
+	 * it can modify the map (the next set is computed after its call)
+	 */
+	template <typename CellType, typename FUNC>
+	void foreach_independent_set(const std::vector<CellType>& cells, const FUNC& func)
+	{
+		static_assert(is_func_parameter_same<FUNC, const std::vector<uint32>&>::value, "Wrong function parameter type");
+
+		std::vector<uint32> pending(cells.size());
+		for (uint32 i = 0u; i < uint32(pending.size()); ++i)
+			pending[i] = i;
+		std::vector<uint32> deferred;
+		std::vector<uint32> set;
+
+		nb_sets_ = 0u;
+		while (!pending.empty())
+		{
+			set.clear();
+			deferred.clear();
+			in_set_.unmark_all();
+			for (uint32 i : pending)
+			{
+				compute_neighbourhood(cells[i]);
+				bool independent = true;
+				for (Dart d : neighbourhood_)
+				{
+					if (in_set_.is_marked(d))
+					{
+						independent = false;
+						break;
+					}
+				}
+				if (independent)
+				{
+					for (Dart d : neighbourhood_)
+						in_set_.mark(d);
+					set.push_back(i);
+				}
+				else
+					deferred.push_back(i);
+			}
+			++nb_sets_;
+			func(set);
+			pending.swap(deferred);
+		}
+	}
+
+	/**
+	 * @brief apply concurrently an operation on the cells of each independent set
+	 * The operations of a set run in the concurrent editing mode of the map (@see MapBase::begin_concurrent_editing):
+	 * they can add and remove darts and attribute lines, and use the topological operations of the map,
+	 * but they must not add or remove attributes or markers.
+	 * @param cells the cells (they must be distinct)
+	 * @param func the operation, called with a cell
+	 * @param nb_darts_per_cell maximum number of darts added by an operation
+	 * @param nb_lines_per_cell maximum number of lines added by an operation in each attribute container
+	 */
+	template <typename CellType, typename FUNC>
+	void parallel_foreach_cell(const std::vector<CellType>& cells, const FUNC& func, uint32 nb_darts_per_cell, uint32 nb_lines_per_cell)
+	{
+		static_assert(is_func_parameter_same<FUNC, CellType>::value, "Wrong function parameter type");
+
+		foreach_independent_set(cells, [&] (const std::vector<uint32>& set)
+		{
+			const uint32 nb_cells = uint32(set.size());
+			map_.begin_concurrent_editing(nb_darts_per_cell * nb_cells, nb_lines_per_cell * nb_cells);
+			parallel_foreach_index(nb_cells, [&] (uint32 k) { func(cells[set[k]]); });
+			map_.end_concurrent_editing();
+		});
+	}
+
+private:
+
+	template <typename CellType>
+	void compute_neighbourhood(CellType c)
+	{
+		neighbourhood_.clear();
+		visited_top_cell_.unmark_all();
+		visited_vertex_.unmark_all();
+
+		auto add_top_cell = [&] (Dart d)
+		{
+			if (!visited_top_cell_.is_marked(d))
+			{
+				map_.foreach_dart_of_orbit(TopCell(d), [&] (Dart td)
+				{
+					visited_top_cell_.mark(td);
+					neighbourhood_.push_back(td);
+				});
+			}
+		};
+		auto add_star = [&] (Dart d)
+		{
+			if (!visited_vertex_.is_marked(d))
+			{
+				map_.foreach_dart_of_orbit(Vertex(d), [&] (Dart vd)
+				{
+					visited_vertex_.mark(vd);
+					add_top_cell(vd);
+				});
+			}
+		};
+
+		if (radius_ == 0u)
+		{
+			map_.foreach_dart_of_orbit(c, add_top_cell);
+			return;
+		}
+
+		map_.foreach_dart_of_orbit(c, add_star);
+		std::size_t begin = 0u;
+		for (uint32 r = 1u; r < radius_; ++r)
+		{
+			const std::size_t end = neighbourhood_.size();
+			for (std::size_t i = begin; i < end; ++i)
+				add_star(neighbourhood_[i]);
+			begin = end;
+		}
+	}
+
+	MAP& map_;
+	uint32 radius_;
+	uint32 nb_sets_;
+	DartMarkerEpoch in_set_;
+	DartMarkerEpoch visited_top_cell_;
+	DartMarkerEpoch visited_vertex_;
+	std::vector<Dart> neighbourhood_;
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_INDEPENDENT_SETS_H_
@@ -0,0 +1,105 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/core/utils/mapped_file.h>
+#include <cgogn/core/utils/logger.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CGOGN_HAS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace cgogn
+{
+
+MappedFile::MappedFile() :
+	data_(nullptr),
+	size_(0u)
+{}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+#ifdef CGOGN_HAS_MMAP
+	const int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		cgogn_log_error("MappedFile::open") << "Unable to open the file \"" << filename << "\".";
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		cgogn_log_error("MappedFile::open") << "Unable to get the size of the file \"" << filename << "\" (or empty file).";
+		::close(fd);
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after the file descriptor is closed
+	::close(fd);
+	if (ptr == MAP_FAILED)
+	{
+		cgogn_log_error("MappedFile::open") << "Unable to map the file \"" << filename << "\".";
+		return false;
+	}
+
+	data_ = static_cast<char*>(ptr);
+	size_ = std::size_t(st.st_size);
+	return true;
+#else
+	cgogn_log_error("MappedFile::open") << "Memory mapped files are not supported on this system (\"" << filename << "\").";
+	return false;
+#endif
+}
+
+void MappedFile::close()
+{
+#ifdef CGOGN_HAS_MMAP
+	if (data_ != nullptr)
+		munmap(data_, size_);
+#endif
+	data_ = nullptr;
+	size_ = 0u;
+}
+
+bool MappedFile::is_supported()
+{
+#ifdef CGOGN_HAS_MMAP
+	return true;
+#else
+	return false;
+#endif
+}
+
+} // namespace cgogn
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_CORE_UTILS_MAPPED_FILE_H_
+#define CGOGN_CORE_UTILS_MAPPED_FILE_H_
+
+#include <string>
+
+#include <cgogn/core/dll.h>
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/definitions.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief private read-write memory mapping of a whole file
+ * The file is opened read-only and mapped copy-on-write : the pages of the mapping are
+ * loaded on first access and only the pages that are written are duplicated in memory,
+ * the file itself is never modified.
+ * Only available on POSIX systems (is_supported() returns false otherwise).
+ */
+class CGOGN_CORE_API MappedFile
+{
+public:
+
+	MappedFile();
+	~MappedFile();
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(MappedFile);
+
+	/**
+	 * @brief map the given file (the previously mapped file, if any, is unmapped)
+	 * @return true if the file could be mapped
+	 */
+	bool open(const std::string& filename);
+
+	void close();
+
+	inline bool is_open() const { return data_ != nullptr; }
+
+	/**
+	 * @brief address of the first byte of the file in the mapping (page aligned)
+	 */
+	inline char* data() const { return data_; }
+
+	inline std::size_t size() const { return size_; }
+
+	static bool is_supported();
+
+private:
+
+	char* data_;
+	std::size_t size_;
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_MAPPED_FILE_H_
@@ -27,6 +27,8 @@
 #include <vector>
 #include <type_traits>
 #include <utility>
+#include <atomic>
+#include <algorithm>
 
 
 #include <cgogn/core/utils/thread.h>
@@ -405,6 +407,46 @@ void parallel_foreach_element(A& a, B& b, C& c, D& d, const FUNC& f)
 }
 #undef CONT
 
+/**
+ * @brief apply f function on each index of [0, n) in parallel
+ * The indices are processed by blocks of consecutive indices that the workers of the thread pool
+ * claim in turn (one task per worker, nothing is copied), f must be callable concurrently on distinct indices.
+ * @param n number of indices
+ * @param f function with 1 param (uint32 index)
+ * @param block_size number of consecutive indices processed by a worker at once
+ */
+template <typename FUNC>
+void parallel_foreach_index(uint32 n, const FUNC& f, uint32 block_size = PARALLEL_BUFFER_SIZE)
+{
+	cgogn_message_assert(block_size > 0u, "parallel_foreach_index: block_size must be positive");
+
+	const uint32 nb_blocks = (n + block_size - 1u) / block_size;
+	ThreadPool* thread_pool = cgogn::thread_pool();
+	const uint32 nb_workers = std::min(thread_pool->nb_workers(), nb_blocks);
+
+	if (nb_workers == 0u)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+			f(i);
+		return;
+	}
+
+	std::atomic<uint32> next_block(0u);
+	TaskGroup group;
+	for (uint32 w = 0u; w < nb_workers; ++w)
+	{
+		thread_pool->enqueue(group, [&] ()
+		{
+			for (uint32 k = next_block++; k < nb_blocks; k = next_block++)
+			{
+				for (uint32 i = k * block_size, end = std::min(n, i + block_size); i < end; ++i)
+					f(i);
+			}
+		});
+	}
+	group.wait();
+}
+
 
 } // namespace cgogn
 
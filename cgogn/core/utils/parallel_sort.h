@@ -0,0 +1,92 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_PARALLEL_SORT_H_
+#define CGOGN_CORE_UTILS_PARALLEL_SORT_H_
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief sort the range [first, last) in parallel
+ * The range is cut in one part per worker of the thread pool, the parts are sorted concurrently
+ * and then merged two by two (the merges of a level are also done concurrently).
+ * Small ranges are sorted by the calling thread. The sort is not stable.
+ * @param first random access iterator on the first element
+ * @param last random access iterator past the last element
+ * @param comp strict weak ordering of the elements
+ */
+template <typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first, RandomIt last, const Compare& comp)
+{
+	const std::size_t n = std::size_t(std::distance(first, last));
+	ThreadPool* thread_pool = cgogn::thread_pool();
+	const uint32 nb_parts = uint32(std::min(std::size_t(thread_pool->nb_workers()), n / PARALLEL_BUFFER_SIZE));
+
+	if (nb_parts < 2u)
+	{
+		std::sort(first, last, comp);
+		return;
+	}
+
+	std::vector<RandomIt> bounds(nb_parts + 1u);
+	for (uint32 i = 0u; i <= nb_parts; ++i)
+		bounds[i] = first + (n * i / nb_parts);
+
+	TaskGroup group;
+	for (uint32 i = 0u; i < nb_parts; ++i)
+		thread_pool->enqueue(group, [&bounds, &comp, i] () { std::sort(bounds[i], bounds[i + 1u], comp); });
+	group.wait();
+
+	for (uint32 step = 1u; step < nb_parts; step *= 2u)
+	{
+		for (uint32 i = 0u; i + step < nb_parts; i += 2u * step)
+		{
+			const uint32 end = std::min(i + 2u * step, nb_parts);
+			thread_pool->enqueue(group, [&bounds, &comp, i, step, end] ()
+			{
+				std::inplace_merge(bounds[i], bounds[i + step], bounds[end], comp);
+			});
+		}
+		group.wait();
+	}
+}
+
+template <typename RandomIt>
+inline void parallel_sort(RandomIt first, RandomIt last)
+{
+	using T = typename std::iterator_traits<RandomIt>::value_type;
+	parallel_sort(first, last, std::less<T>());
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_PARALLEL_SORT_H_
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_REDUCTION_H_
+#define CGOGN_CORE_UTILS_REDUCTION_H_
+
+#include <vector>
+#include <utility>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/assert.h>
+
+namespace cgogn
+{
+
+/// size of the padding that separates the partial results of two threads
+const uint32 CACHE_LINE_SIZE = 64u;
+
+/**
+ * @brief The ReductionPartials class stores the partial results of a parallel reduction
+ * There is one partial per slot (a worker thread or a block of indices). Each partial
+ * is padded to a cache line so that concurrent accumulations do not falsely share memory.
+ * The partials are combined in slot order, so that the final combination does not depend
+ * on the scheduling of the tasks.
+ * @tparam T type of the reduced value
+ */
+template <typename T>
+class ReductionPartials
+{
+	struct Partial
+	{
+		T value_;
+		bool valid_;
+		char padding_[CACHE_LINE_SIZE];
+	};
+
+	std::vector<Partial> partials_;
+
+public:
+
+	/**
+	 * @brief ReductionPartials
+	 * @param nb_slots number of partials
+	 * @param init value used to construct the partials (it is never combined)
+	 */
+	inline ReductionPartials(uint32 nb_slots, const T& init) :
+		partials_(nb_slots, Partial{init, false, {}})
+	{}
+
+	/**
+	 * @brief combine a value into the partial of the given slot
+	 * The first value given to a slot becomes its partial.
+	 * A slot must only be used by one thread at a time.
+	 */
+	template <typename U, typename CombineFunc>
+	inline void accumulate(uint32 slot, U&& value, const CombineFunc& combine_fn)
+	{
+		cgogn_message_assert(slot < partials_.size(), "ReductionPartials: slot out of range");
+		Partial& p = partials_[slot];
+		if (p.valid_)
+			p.value_ = combine_fn(p.value_, std::forward<U>(value));
+		else
+		{
+			p.value_ = std::forward<U>(value);
+			p.valid_ = true;
+		}
+	}
+
+	/**
+	 * @brief combine init and the valid partials in slot order
+	 */
+	template <typename CombineFunc>
+	inline T result(const T& init, const CombineFunc& combine_fn) const
+	{
+		T res = init;
+		for (const Partial& p : partials_)
+		{
+			if (p.valid_)
+				res = combine_fn(res, p.value_);
+		}
+		return res;
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_REDUCTION_H_
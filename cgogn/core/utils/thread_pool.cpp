@@ -28,13 +28,108 @@ namespace cgogn
 
 {
 
+namespace
+{
+
+// pool and index of the worker running on the current thread (nullptr for non-worker threads)
+CGOGN_TLS ThreadPool* current_pool_ = nullptr;
+CGOGN_TLS uint32 current_worker_ = 0u;
+
+} // namespace
+
+/**
+ * @brief deque of tasks of a worker
+ * The owner pushes and pops at the back, thieves (and external threads) pop at the front.
+ * It is stored in a growing ring buffer, so that no allocation happens once the
+ * capacity is sufficient. Padded to avoid false sharing between workers.
+ */
+class ThreadPool::WorkerQueue
+{
+public:
+
+	inline WorkerQueue() :
+		head_(0u),
+		size_(0u)
+	{
+		tasks_.resize(64u);
+	}
+
+	inline void push_back(ThreadTask&& task)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == tasks_.size())
+			grow();
+		tasks_[(head_ + size_) % tasks_.size()] = std::move(task);
+		++size_;
+	}
+
+	inline bool pop_back(ThreadTask& task)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == 0u)
+			return false;
+		--size_;
+		task = std::move(tasks_[(head_ + size_) % tasks_.size()]);
+		return true;
+	}
+
+	inline bool pop_front(ThreadTask& task)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == 0u)
+			return false;
+		task = std::move(tasks_[head_]);
+		head_ = (head_ + 1u) % tasks_.size();
+		--size_;
+		return true;
+	}
+
+private:
+
+	inline void grow()
+	{
+		std::vector<ThreadTask> tasks(2u * tasks_.size());
+		for (std::size_t i = 0u; i < size_; ++i)
+			tasks[i] = std::move(tasks_[(head_ + i) % tasks_.size()]);
+		tasks_.swap(tasks);
+		head_ = 0u;
+	}
+
+	char padding_front_[64];
+	std::mutex mutex_;
+	std::vector<ThreadTask> tasks_;
+	std::size_t head_;
+	std::size_t size_;
+	char padding_back_[64];
+};
+
+void TaskGroup::done()
+{
+	if (nb_pending_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		condition_.notify_all();
+	}
+}
+
+void TaskGroup::wait()
+{
+	if (nb_pending_.load(std::memory_order_acquire) == 0u)
+		return;
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this] { return nb_pending_.load(std::memory_order_acquire) == 0u; });
+}
+
 ThreadPool::~ThreadPool()
 {
 	nb_working_workers_ = uint32(workers_.size());
-	condition_running_.notify_all();
+	{
+		std::lock_guard<std::mutex> lock(running_mutex_);
+		condition_running_.notify_all();
+	}
 
 	{
-		std::unique_lock<std::mutex> lock(queue_mutex_);
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
 		stop_ = true;
 	}
 #if !(defined(CGOGN_WIN_VER) && (CGOGN_WIN_VER <= 61))
@@ -45,61 +140,96 @@ ThreadPool::~ThreadPool()
 		worker.join();
 }
 
-
-
 ThreadPool::ThreadPool(const std::string& name, uint32 shift_index)
-	:  name_(name), stop_(false), shift_index_(shift_index)
+	:  name_(name), next_queue_(0u), nb_pending_tasks_(0u), stop_(false), shift_index_(shift_index)
 {
 	uint32 nb_ww = std::thread::hardware_concurrency();
 	this->nb_working_workers_ = nb_ww;
-	for(uint32 i = 0u; i< nb_ww; ++i)
+	queues_.reserve(nb_ww);
+	for (uint32 i = 0u; i < nb_ww; ++i)
+		queues_.emplace_back(new WorkerQueue());
+	for (uint32 i = 0u; i < nb_ww; ++i)
+		workers_.emplace_back([this, i] () { this->worker_loop(i); });
+}
+
+void ThreadPool::push_task(ThreadTask&& task)
+{
+	// don't allow enqueueing after stopping the pool
+	if (stop_)
 	{
-		workers_.emplace_back(
-		[this, i] () -> void
-		{
-			cgogn::thread_start(i,this->shift_index_);
-			for(;;)
-			{
-				while (i >= this->nb_working_workers_)
-				{
-					std::unique_lock<std::mutex> lock(this->running_mutex_);
-					this->condition_running_.wait(lock);
-				}
-
-				std::unique_lock<std::mutex> lock(this->queue_mutex_);
-				this->condition_.wait(
-					lock,
-					[this] { return this->stop_ || !this->tasks_.empty(); }
-				);
-
-				if (this->stop_ && this->tasks_.empty())
-				{
-					cgogn::thread_stop();
-					return;
-				}
-
-				if (i < this->nb_working_workers_)
-				{
-					PackagedTask task = std::move(this->tasks_.front());
-					this->tasks_.pop();
-					lock.unlock();
-#if defined(_MSC_VER) && _MSC_VER < 1900
-					(*task)();
-#else
-					task();
-#endif
-				}
-				else
-				{
-					lock.unlock();
-					condition_.notify_one();
-				}
-			}
-		});
+		cgogn_log_error("ThreadPool::enqueue") << "Enqueue on stopped ThreadPool.";
+		cgogn_assert_not_reached("enqueue on stopped ThreadPool");
+	}
+
+	if (current_pool_ == this)
+		queues_[current_worker_]->push_back(std::move(task));
+	else
+	{
+		const uint32 nb = std::max(1u, std::min(uint32(queues_.size()), nb_working_workers_.load()));
+		queues_[next_queue_.fetch_add(1u, std::memory_order_relaxed) % nb]->push_back(std::move(task));
+	}
+
+	nb_pending_tasks_.fetch_add(1u, std::memory_order_release);
+
+	// Notify a thread that there is new work to perform
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+	}
+	condition_.notify_one();
+}
+
+bool ThreadPool::pop_task(uint32 worker, ThreadTask& task)
+{
+	if (queues_[worker]->pop_back(task))
+		return true;
+
+	// steal the oldest task of another worker
+	const uint32 nb = uint32(queues_.size());
+	for (uint32 i = 1u; i < nb; ++i)
+	{
+		if (queues_[(worker + i) % nb]->pop_front(task))
+			return true;
 	}
+	return false;
 }
 
+void ThreadPool::worker_loop(uint32 i)
+{
+	cgogn::thread_start(i, this->shift_index_);
+	current_pool_ = this;
+	current_worker_ = i;
 
+	ThreadTask task;
+	for(;;)
+	{
+		while (i >= this->nb_working_workers_ && !this->stop_)
+		{
+			std::unique_lock<std::mutex> lock(this->running_mutex_);
+			this->condition_running_.wait(lock, [this, i] { return i < this->nb_working_workers_ || this->stop_; });
+		}
+
+		if (pop_task(i, task))
+		{
+			nb_pending_tasks_.fetch_sub(1u, std::memory_order_acq_rel);
+			task();
+			task = ThreadTask();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(this->sleep_mutex_);
+		this->condition_.wait(
+			lock,
+			[this, i] { return this->stop_ || this->nb_pending_tasks_ > 0u || i >= this->nb_working_workers_; }
+		);
+
+		if (this->stop_ && this->nb_pending_tasks_ == 0u)
+		{
+			current_pool_ = nullptr;
+			cgogn::thread_stop();
+			return;
+		}
+	}
+}
 
 void ThreadPool::set_nb_workers(uint32 nb )
 {
@@ -108,10 +238,16 @@ void ThreadPool::set_nb_workers(uint32 nb )
 	else
 		nb_working_workers_ = std::min(uint32(workers_.size()), nb);
 
-	condition_running_.notify_all();
+	{
+		std::lock_guard<std::mutex> lock(running_mutex_);
+		condition_running_.notify_all();
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		condition_.notify_all();
+	}
 
 	cgogn_log_info("ThreadPool") << name_ << " using " << nb_working_workers_ << " thread-workers";
 }
 
 } // namespace cgogn
-
@@ -57,13 +57,16 @@
 #define CGOGN_CORE_UTILS_THREADPOOL_H_
 
 #include <vector>
-#include <queue>
 #include <memory>
+#include <new>
+#include <cstddef>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <functional>
+#include <type_traits>
 
 #include <cgogn/core/utils/logger.h>
 #include <cgogn/core/utils/assert.h>
@@ -72,6 +75,185 @@
 namespace cgogn
 {
 
+/**
+ * @brief type-erased non-returning callable, used as the unit of work of the ThreadPool
+ * Callables whose size is at most INLINE_SIZE (typically lambdas capturing a few references)
+ * are stored inside the task itself, so that they can be submitted without any heap allocation.
+ */
+class CGOGN_CORE_API ThreadTask final
+{
+public:
+
+	static const std::size_t INLINE_SIZE = 48u;
+
+	inline ThreadTask() : invoke_(nullptr), manage_(nullptr)
+	{}
+
+	template <typename F,
+			  typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, ThreadTask>::value>::type>
+	inline ThreadTask(F&& f) : invoke_(nullptr), manage_(nullptr)
+	{
+		using Func = typename std::decay<F>::type;
+		emplace<Func>(std::forward<F>(f), FitsInline<Func>());
+	}
+
+	inline ThreadTask(ThreadTask&& t) : invoke_(nullptr), manage_(nullptr)
+	{
+		move_from(t);
+	}
+
+	inline ThreadTask& operator=(ThreadTask&& t)
+	{
+		if (this != &t)
+		{
+			reset();
+			move_from(t);
+		}
+		return *this;
+	}
+
+	ThreadTask(const ThreadTask&) = delete;
+	ThreadTask& operator=(const ThreadTask&) = delete;
+
+	inline ~ThreadTask()
+	{
+		reset();
+	}
+
+	inline bool is_valid() const
+	{
+		return invoke_ != nullptr;
+	}
+
+	inline void operator()()
+	{
+		cgogn_message_assert(is_valid(), "ThreadTask: calling an empty task");
+		invoke_(&storage_);
+	}
+
+private:
+
+	enum Operation
+	{
+		MOVE = 0,
+		DESTROY
+	};
+
+	using Storage = typename std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type;
+
+	template <typename Func>
+	struct FitsInline : public std::integral_constant<bool,
+		(sizeof(Func) <= INLINE_SIZE) &&
+		(alignof(Func) <= alignof(std::max_align_t)) &&
+		std::is_nothrow_move_constructible<Func>::value>
+	{};
+
+	// inline storage
+	template <typename Func, typename F>
+	inline void emplace(F&& f, std::true_type)
+	{
+		new (&storage_) Func(std::forward<F>(f));
+		invoke_ = [] (void* s) { (*static_cast<Func*>(s))(); };
+		manage_ = [] (Operation op, void* dst, void* src)
+		{
+			Func* fsrc = static_cast<Func*>(src);
+			if (op == MOVE)
+				new (dst) Func(std::move(*fsrc));
+			fsrc->~Func();
+		};
+	}
+
+	// heap storage (the inline storage holds the pointer)
+	template <typename Func, typename F>
+	inline void emplace(F&& f, std::false_type)
+	{
+		*reinterpret_cast<Func**>(&storage_) = new Func(std::forward<F>(f));
+		invoke_ = [] (void* s) { (**static_cast<Func**>(s))(); };
+		manage_ = [] (Operation op, void* dst, void* src)
+		{
+			Func** fsrc = static_cast<Func**>(src);
+			if (op == MOVE)
+				*static_cast<Func**>(dst) = *fsrc;
+			else
+				delete *fsrc;
+		};
+	}
+
+	inline void move_from(ThreadTask& t)
+	{
+		if (t.is_valid())
+		{
+			t.manage_(MOVE, &storage_, &t.storage_);
+			invoke_ = t.invoke_;
+			manage_ = t.manage_;
+			t.invoke_ = nullptr;
+			t.manage_ = nullptr;
+		}
+	}
+
+	inline void reset()
+	{
+		if (is_valid())
+		{
+			manage_(DESTROY, nullptr, &storage_);
+			invoke_ = nullptr;
+			manage_ = nullptr;
+		}
+	}
+
+	Storage storage_;
+	void (*invoke_)(void*);
+	void (*manage_)(Operation, void*, void*);
+};
+
+/**
+ * @brief counter of pending tasks that allows to wait for a set of tasks
+ * enqueued without futures (i.e. without any allocation)
+ */
+class CGOGN_CORE_API TaskGroup final
+{
+public:
+
+	inline TaskGroup() : nb_pending_(0u)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(TaskGroup);
+
+	inline ~TaskGroup()
+	{
+		wait();
+	}
+
+	/**
+	 * @brief block the calling thread until all the tasks of the group are done
+	 */
+	void wait();
+
+private:
+
+	friend class ThreadPool;
+
+	inline void add()
+	{
+		nb_pending_.fetch_add(1u, std::memory_order_relaxed);
+	}
+
+	void done();
+
+#pragma warning(push)
+#pragma warning(disable:4251)
+	std::atomic<uint32> nb_pending_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+#pragma warning(pop)
+};
+
+/**
+ * @brief pool of threads with one task deque per worker and work stealing
+ * Tasks enqueued from a worker are pushed on its own deque (and popped LIFO by it),
+ * tasks enqueued from an external thread are distributed in a round-robin fashion.
+ * An idle worker steals the oldest tasks of the other deques before going to sleep.
+ */
 class CGOGN_CORE_API ThreadPool final
 {
 public:
@@ -88,6 +270,13 @@ public:
 	template <class F, class... Args>
 	std::future<void> enqueue(const F& f, Args&&... args);
 
+	/**
+	 * @brief enqueue a task belonging to the given group (no future is created)
+	 * The task is stored inline (no allocation) if the callable is small enough.
+	 */
+	template <class F>
+	void enqueue(TaskGroup& group, F&& f);
+
 	~ThreadPool();
 
 	/**
@@ -113,6 +302,15 @@ public:
 	void set_nb_workers(uint32 nb = 0xffffffff);
 
 private:
+
+	class WorkerQueue;
+
+	void push_task(ThreadTask&& task);
+
+	bool pop_task(uint32 worker, ThreadTask& task);
+
+	void worker_loop(uint32 worker);
+
 #pragma warning(push)
 #pragma warning(disable:4251)
 
@@ -121,16 +319,20 @@ private:
 
 	// need to keep track of threads so we can join them
 	std::vector<std::thread> workers_;
-	// the task queue
-	std::queue<PackagedTask> tasks_;
+	// one task deque per worker
+	std::vector<std::unique_ptr<WorkerQueue>> queues_;
+	// index of the next deque that receives a task from an external thread
+	std::atomic<uint32> next_queue_;
+	// number of tasks enqueued and not yet started
+	std::atomic<uint32> nb_pending_tasks_;
 
-	// synchronization
-	std::mutex queue_mutex_;
+	// synchronization of sleeping workers
+	std::mutex sleep_mutex_;
 	std::condition_variable condition_;
-	bool stop_;
+	std::atomic<bool> stop_;
 
 	// limit usage to the n-th first workers
-	uint32 nb_working_workers_;
+	std::atomic<uint32> nb_working_workers_;
 	std::mutex running_mutex_;
 	std::condition_variable condition_running_;
 
@@ -141,7 +343,6 @@ private:
 
 // add new work item to the pool
 
-
 template <class F, class... Args>
 std::future<void> ThreadPool::enqueue(const F& f, Args&&... args)
 {
@@ -150,30 +351,36 @@ std::future<void> ThreadPool::enqueue(const F& f, Args&&... args)
 #if defined(_MSC_VER) && _MSC_VER < 1900
 	PackagedTask task = std::make_shared<std::packaged_task<void()>>(std::bind(f, std::forward<Args>(args)...));
 	std::future<void> res = task->get_future();
+	push_task(ThreadTask([task] () { (*task)(); }));
 #else
 	PackagedTask task([&, f]() -> void
 	{
 		f(std::forward<Args>(args)...);
 	});
 	std::future<void> res = task.get_future();
+	push_task(ThreadTask(std::move(task)));
 #endif
 
-	{
-		std::unique_lock<std::mutex> lock(queue_mutex_);
-		// don't allow enqueueing after stopping the pool
-		if (stop_)
-		{
-			cgogn_log_error("ThreadPool::enqueue") << "Enqueue on stopped ThreadPool.";
-			cgogn_assert_not_reached("enqueue on stopped ThreadPool");
-		}
-		// Push work back on the queue
-		tasks_.push(std::move(task));
-	}
-	// Notify a thread that there is new work to perform
-	condition_.notify_one();
 	return res;
 }
 
+template <class F>
+void ThreadPool::enqueue(TaskGroup& group, F&& f)
+{
+	using Func = typename std::decay<F>::type;
+	static_assert(std::is_same<typename std::result_of<Func()>::type, void>::value, "The thread pool only accept non-returning functions.");
+
+	struct GroupTask
+	{
+		Func f_;
+		TaskGroup* group_;
+		inline void operator()() { f_(); group_->done(); }
+	};
+
+	group.add();
+	push_task(ThreadTask(GroupTask{std::forward<F>(f), &group}));
+}
+
 /**
  * launch an external thread
  */
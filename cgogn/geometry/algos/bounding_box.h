@@ -45,11 +45,25 @@ void compute_AABB(const ATTR& attr, AABB<array_data_type<ATTR>>& bb)
 template <typename ATTR, typename MAP>
 void compute_AABB(const ATTR& attr, const MAP& map, AABB<array_data_type<ATTR>>& bb)
 {
-	bb.reset();
-	map.foreach_cell([&] (Cell<ATTR::orb_> c)
-	{
-		bb.add_point(attr[c]);
-	});
+	using BoundingBox = AABB<array_data_type<ATTR>>;
+
+	bb = map.parallel_reduce_cell(
+		BoundingBox(),
+		[&] (Cell<ATTR::orb_> c)
+		{
+			return BoundingBox(attr[c]);
+		},
+		[] (const BoundingBox& a, const BoundingBox& b)
+		{
+			BoundingBox res = a;
+			if (b.is_initialized())
+			{
+				res.add_point(b.min());
+				res.add_point(b.max());
+			}
+			return res;
+		}
+	);
 }
 
 template <typename ATTR>
@@ -28,6 +28,9 @@
 #include <cgogn/core/basic/cell.h>
 #include <cgogn/core/utils/masks.h>
 
+#include <utility>
+#include <limits>
+
 namespace cgogn
 {
 
@@ -85,26 +88,26 @@ inline auto centroid(
 	const typename MAP::template VertexAttribute<VEC>& attribute
 ) -> typename std::enable_if<!is_cell_type<MASK>::value, VEC>::type
 {
-	std::vector<VEC> sum_per_thread(thread_pool()->nb_workers());
-	for (VEC& v :sum_per_thread) { set_zero(v); }
-	std::vector<uint32> nb_vertices_per_thread(thread_pool()->nb_workers(), 0);
-
-	map.parallel_foreach_cell([&] (typename MAP::Vertex v)
-	{
-		uint32 thread_index = current_thread_index();
+	using SumCount = std::pair<VEC, uint32>;
 
-		sum_per_thread[thread_index] += attribute[v];
-		++nb_vertices_per_thread[thread_index];
-	},
-	mask);
+	SumCount zero;
+	set_zero(zero.first);
+	zero.second = 0u;
 
-	VEC result;
-	set_zero(result);
-	uint32 nbv = 0;
-	for (VEC& v : sum_per_thread) result += v;
-	for (uint32 n : nb_vertices_per_thread) nbv += n;
+	const SumCount sum = map.parallel_reduce_cell(
+		zero,
+		[&] (typename MAP::Vertex v)
+		{
+			return SumCount(attribute[v], 1u);
+		},
+		[] (const SumCount& a, const SumCount& b)
+		{
+			return SumCount(a.first + b.first, a.second + b.second);
+		},
+		mask
+	);
 
-	return result / typename vector_traits<VEC>::Scalar(nbv);
+	return sum.first / typename vector_traits<VEC>::Scalar(sum.second);
 }
 
 template <typename VEC, typename MAP>
@@ -128,25 +131,25 @@ typename MAP::Vertex central_vertex(
 
 	VEC center = centroid<VEC, MAP>(map, mask, attribute);
 
-	std::vector<double> min_dist_per_thread(thread_pool()->nb_workers(), std::numeric_limits<Scalar>::max());
-	std::vector<Vertex> min_vertex_per_thread(thread_pool()->nb_workers());
-
-	map.parallel_foreach_cell([&] (Vertex v)
-	{
-		uint32 thread_index = current_thread_index();
-
-		Scalar distance = (attribute[v] - center).squaredNorm();
+	using DistVertex = std::pair<Scalar, Vertex>;
 
-		if (distance < min_dist_per_thread[thread_index])
+	// on equal distances, the vertex of smallest dart index is kept so that the result is deterministic
+	const DistVertex closest = map.parallel_reduce_cell(
+		DistVertex(std::numeric_limits<Scalar>::max(), Vertex()),
+		[&] (Vertex v)
 		{
-			min_dist_per_thread[thread_index] = distance;
-			min_vertex_per_thread[thread_index] = v;
-		}
-	},
-	mask);
-
-	uint32 min_pos = std::distance(min_dist_per_thread.begin(), std::min_element(min_dist_per_thread.begin(), min_dist_per_thread.end()));
-	return min_vertex_per_thread[min_pos];
+			return DistVertex((attribute[v] - center).squaredNorm(), v);
+		},
+		[] (const DistVertex& a, const DistVertex& b)
+		{
+			if (b.first < a.first || (b.first == a.first && b.second.dart.index < a.second.dart.index))
+				return b;
+			return a;
+		},
+		mask
+	);
+
+	return closest.second;
 }
 
 template <typename VEC, typename MAP>
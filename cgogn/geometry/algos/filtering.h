@@ -25,7 +25,9 @@
 #define CGOGN_GEOMETRY_ALGOS_FILTERING_H_
 
 #include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/functions/basics.h>
 #include <cgogn/core/utils/masks.h>
+#include <cgogn/core/cmap/attribute.h>
 
 namespace cgogn
 {
@@ -33,13 +35,11 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename T, typename MAP, typename MASK>
-void filter_average(
-	const MAP& map,
-	const MASK& mask,
-	const typename MAP::template VertexAttribute<T>& attribute_in,
-	typename MAP::template VertexAttribute<T>& attribute_out
-)
+namespace internal
+{
+
+template <typename T, typename MAP, typename MASK, typename ATTR_IN, typename ATTR_OUT>
+void filter_average(const MAP& map, const MASK& mask, const ATTR_IN& attribute_in, ATTR_OUT& attribute_out)
 {
 	using Scalar = typename vector_traits<T>::Scalar;
 	using Vertex = typename MAP::Vertex;
@@ -54,11 +54,24 @@ void filter_average(
 			sum += attribute_in[av];
 			++count;
 		});
-		attribute_out[v] = sum / Scalar(count);
+		attribute_out[v] = T(sum / Scalar(count));
 	},
 	mask);
 }
 
+} // namespace internal
+
+template <typename T, typename MAP, typename MASK>
+void filter_average(
+	const MAP& map,
+	const MASK& mask,
+	const typename MAP::template VertexAttribute<T>& attribute_in,
+	typename MAP::template VertexAttribute<T>& attribute_out
+)
+{
+	internal::filter_average<T>(map, mask, attribute_in, attribute_out);
+}
+
 template <typename T, typename MAP>
 void filter_average(
 	const MAP& map,
@@ -69,6 +82,30 @@ void filter_average(
 	filter_average<T>(map, AllCellsFilter(), attribute_in, attribute_out);
 }
 
+/**
+ * @brief version of filter_average for attributes stored with a structure of arrays layout
+ */
+template <typename T, typename MAP, typename MASK>
+void filter_average(
+	const MAP& map,
+	const MASK& mask,
+	const AttributeSoA<T, MAP::Vertex::ORBIT>& attribute_in,
+	AttributeSoA<T, MAP::Vertex::ORBIT>& attribute_out
+)
+{
+	internal::filter_average<T>(map, mask, attribute_in, attribute_out);
+}
+
+template <typename T, typename MAP>
+void filter_average(
+	const MAP& map,
+	const AttributeSoA<T, MAP::Vertex::ORBIT>& attribute_in,
+	AttributeSoA<T, MAP::Vertex::ORBIT>& attribute_out
+)
+{
+	filter_average<T>(map, AllCellsFilter(), attribute_in, attribute_out);
+}
+
 template <typename VEC3, typename MAP, typename MASK>
 void filter_bilateral(
 	const MAP& map,
@@ -82,22 +119,30 @@ void filter_bilateral(
 	using Vertex = typename MAP::Vertex;
 	using Edge = typename MAP::Edge;
 
-	Scalar length_sum = 0;
-	Scalar angle_sum = 0;
-	uint32 nb_edges = 0;
-
-	map.foreach_cell([&] (Edge e)
+	struct EdgeSums
 	{
-		std::pair<Vertex, Vertex> v = map.vertices(e);
-		VEC3 edge = position_in[v.first] - position_in[v.second];
-		length_sum += edge.norm();
-		angle_sum += angle(normal[v.first], normal[v.second]);
-		++nb_edges;
-	},
-	mask);
+		Scalar length_;
+		Scalar angle_;
+		uint32 nb_edges_;
+	};
+
+	const EdgeSums sums = map.parallel_reduce_cell(
+		EdgeSums{Scalar(0), Scalar(0), 0u},
+		[&] (Edge e)
+		{
+			std::pair<Vertex, Vertex> v = map.vertices(e);
+			VEC3 edge = position_in[v.first] - position_in[v.second];
+			return EdgeSums{Scalar(edge.norm()), Scalar(angle(normal[v.first], normal[v.second])), 1u};
+		},
+		[] (const EdgeSums& a, const EdgeSums& b)
+		{
+			return EdgeSums{a.length_ + b.length_, a.angle_ + b.angle_, a.nb_edges_ + b.nb_edges_};
+		},
+		mask
+	);
 
-	Scalar sigmaC = 1.0 * (length_sum / Scalar(nb_edges));
-	Scalar sigmaS = 2.5 * (angle_sum / Scalar(nb_edges));
+	Scalar sigmaC = 1.0 * (sums.length_ / Scalar(sums.nb_edges_));
+	Scalar sigmaS = 2.5 * (sums.angle_ / Scalar(sums.nb_edges_));
 
 	map.parallel_foreach_cell([&] (Vertex v)
 	{
@@ -30,6 +30,8 @@
 #include <cgogn/core/utils/masks.h>
 #include <cgogn/core/utils/thread.h>
 
+#include <utility>
+
 namespace cgogn
 {
 
@@ -92,24 +94,22 @@ inline typename vector_traits<VEC3>::Scalar mean_edge_length(
 {
 	using Scalar = typename vector_traits<VEC3>::Scalar;
 	using Edge = typename MAP::Edge;
-
-	std::vector<Scalar> edge_length_per_thread(thread_pool()->nb_workers(), 0);
-	std::vector<uint32> nb_edges_per_thread(thread_pool()->nb_workers(), 0);
-
-	map.parallel_foreach_cell([&] (Edge e)
-	{
-		uint32 thread_index =cgogn::current_thread_index();
-		edge_length_per_thread[thread_index] += ::cgogn::geometry::length<VEC3>(map, e, position);
-		++nb_edges_per_thread[thread_index];
-	},
-	mask);
-
-	Scalar length = 0;
-	uint32 nbe = 0;
-	for (Scalar l : edge_length_per_thread) length += l;
-	for (uint32 n : nb_edges_per_thread) nbe += n;
-
-	return length / Scalar(nbe);
+	using LengthCount = std::pair<Scalar, uint32>;
+
+	const LengthCount sum = map.parallel_reduce_cell(
+		LengthCount(Scalar(0), 0u),
+		[&] (Edge e)
+		{
+			return LengthCount(::cgogn::geometry::length<VEC3>(map, e, position), 1u);
+		},
+		[] (const LengthCount& a, const LengthCount& b)
+		{
+			return LengthCount(a.first + b.first, a.second + b.second);
+		},
+		mask
+	);
+
+	return sum.first / Scalar(sum.second);
 }
 
 template <typename VEC3, typename MAP>
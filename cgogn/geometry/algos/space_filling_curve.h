@@ -0,0 +1,214 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_GEOMETRY_ALGOS_SPACE_FILLING_CURVE_H_
+#define CGOGN_GEOMETRY_ALGOS_SPACE_FILLING_CURVE_H_
+
+#include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/core/cmap/attribute.h>
+#include <cgogn/core/basic/cell.h>
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <utility>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+enum class SpaceFillingCurve
+{
+	MORTON,
+	HILBERT
+};
+
+namespace internal
+{
+
+/**
+ * @brief position of a point of the grid [0, 2^bits[^D along the curve (D * bits <= 64)
+ * The Hilbert index is computed with the transposition algorithm of J. Skilling ("Programming the Hilbert curve", 2004)
+ * before the interleaving of the bits that gives the Morton index.
+ */
+template <std::size_t D>
+inline uint64 curve_key(std::array<uint32, D> x, uint32 bits, SpaceFillingCurve curve)
+{
+	if (curve == SpaceFillingCurve::HILBERT && D > 1u)
+	{
+		const uint32 m = 1u << (bits - 1u);
+		// inverse undo
+		for (uint32 q = m; q > 1u; q >>= 1u)
+		{
+			const uint32 p = q - 1u;
+			for (std::size_t i = 0u; i < D; ++i)
+			{
+				if (x[i] & q)
+					x[0] ^= p;
+				else
+				{
+					const uint32 t = (x[0] ^ x[i]) & p;
+					x[0] ^= t;
+					x[i] ^= t;
+				}
+			}
+		}
+		// Gray encode
+		for (std::size_t i = 1u; i < D; ++i)
+			x[i] ^= x[i - 1u];
+		uint32 t = 0u;
+		for (uint32 q = m; q > 1u; q >>= 1u)
+		{
+			if (x[D - 1u] & q)
+				t ^= q - 1u;
+		}
+		for (std::size_t i = 0u; i < D; ++i)
+			x[i] ^= t;
+	}
+
+	uint64 key = 0u;
+	for (uint32 b = bits; b-- > 0u;)
+	{
+		for (std::size_t i = 0u; i < D; ++i)
+			key = (key << 1u) | ((x[i] >> b) & 1u);
+	}
+	return key;
+}
+
+/**
+ * @brief compute the position along the curve of the values of an attribute
+ * The bounding box of the values is mapped on the grid of the curve.
+ * @return the pairs (key, index of the value)
+ */
+template <typename VEC, Orbit ORBIT>
+std::vector<std::pair<uint64, uint32>> curve_keys(const Attribute<VEC, ORBIT>& position, SpaceFillingCurve curve)
+{
+	using Scalar = typename vector_traits<VEC>::Scalar;
+	static const std::size_t D = vector_traits<VEC>::SIZE;
+	static const uint32 bits = 64u / D < 32u ? uint32(64u / D) : 32u;
+
+	std::array<Scalar, D> min;
+	std::array<Scalar, D> max;
+	bool first = true;
+	for (const VEC& p : position)
+	{
+		for (std::size_t i = 0u; i < D; ++i)
+		{
+			min[i] = first ? p[i] : std::min(min[i], p[i]);
+			max[i] = first ? p[i] : std::max(max[i], p[i]);
+		}
+		first = false;
+	}
+
+	const float64 grid_max = float64((uint64(1u) << bits) - 1u);
+	std::array<float64, D> scale;
+	for (std::size_t i = 0u; i < D; ++i)
+		scale[i] = max[i] > min[i] ? grid_max / float64(max[i] - min[i]) : 0.0;
+
+	std::vector<std::pair<uint64, uint32>> keys;
+	for (auto it = position.begin(); it != position.end(); ++it)
+	{
+		const VEC& p = *it;
+		std::array<uint32, D> x;
+		for (std::size_t i = 0u; i < D; ++i)
+			x[i] = uint32(float64(p[i] - min[i]) * scale[i]);
+		keys.emplace_back(curve_key<D>(x, bits, curve), it.index());
+	}
+	return keys;
+}
+
+} // namespace internal
+
+/**
+ * @brief compute the order of the cells of an attribute along a space filling curve
+ * The curve visits the bounding box of the values of the attribute (e.g. positions of vertices or centroids of faces),
+ * the cells that are close along the curve are close in space.
+ * @param position the attribute that gives the position of each cell
+ * @param curve the space filling curve (Hilbert has a better locality, Morton is cheaper)
+ * @return the indices of the cells along the curve (@see MapBase::reorder_cells)
+ */
+template <typename VEC, Orbit ORBIT>
+std::vector<uint32> space_filling_curve_order(const Attribute<VEC, ORBIT>& position, SpaceFillingCurve curve = SpaceFillingCurve::HILBERT)
+{
+	std::vector<std::pair<uint64, uint32>> keys = internal::curve_keys(position, curve);
+	std::sort(keys.begin(), keys.end());
+	std::vector<uint32> order;
+	order.reserve(keys.size());
+	for (const auto& k : keys)
+		order.push_back(k.second);
+	return order;
+}
+
+/**
+ * @brief compute the order of the darts along a space filling curve: the darts are sorted by the position of their vertex
+ * @param map the map
+ * @param position the position of the vertices
+ * @param curve the space filling curve
+ * @return all the darts of the map along the curve (@see MapBase::reorder_darts)
+ */
+template <typename VEC, typename MAP>
+std::vector<Dart> space_filling_curve_dart_order(const MAP& map, const typename MAP::template VertexAttribute<VEC>& position, SpaceFillingCurve curve = SpaceFillingCurve::HILBERT)
+{
+	using Vertex = typename MAP::Vertex;
+
+	std::vector<std::pair<uint64, uint32>> keys = internal::curve_keys(position, curve);
+	std::vector<uint64> vertex_key(map.template attribute_container<Vertex::ORBIT>().end());
+	for (const auto& k : keys)
+		vertex_key[k.second] = k.first;
+
+	std::vector<std::pair<uint64, uint32>> dart_keys;
+	dart_keys.reserve(map.nb_darts());
+	map.foreach_dart([&] (Dart d)
+	{
+		dart_keys.emplace_back(vertex_key[map.embedding(Vertex(d))], d.index);
+	});
+	std::sort(dart_keys.begin(), dart_keys.end());
+
+	std::vector<Dart> order;
+	order.reserve(dart_keys.size());
+	for (const auto& k : dart_keys)
+		order.push_back(Dart(k.second));
+	return order;
+}
+
+/**
+ * @brief reorder the darts and the vertices of a map along a space filling curve to improve the locality of the traversals
+ * @param map the map
+ * @param position the position of the vertices
+ * @param curve the space filling curve
+ */
+template <typename VEC, typename MAP>
+void reorder_along_curve(MAP& map, const typename MAP::template VertexAttribute<VEC>& position, SpaceFillingCurve curve = SpaceFillingCurve::HILBERT)
+{
+	map.reorder_darts(space_filling_curve_dart_order<VEC>(map, position, curve));
+	map.template reorder_cells<typename MAP::Vertex>(space_filling_curve_order(position, curve));
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_SPACE_FILLING_CURVE_H_
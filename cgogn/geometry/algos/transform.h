@@ -0,0 +1,298 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_TRANSFORM_H_
+#define CGOGN_GEOMETRY_ALGOS_TRANSFORM_H_
+
+#include <type_traits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/cmap/attribute.h>
+#include <cgogn/core/container/chunk_array_container.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/types/eigen.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+namespace internal
+{
+
+/**
+ * The kernels below apply an affine transformation to the used lines of one chunk of 3D positions.
+ * in and out point on the chunk data, mask is the ChunkMask of the chunk and m is a 4x4 matrix
+ * stored in column-major order (its last row is ignored). in and out may be the same chunk.
+ */
+
+template <typename Scalar, typename MASK>
+inline void transform_chunk_scalar(const Scalar* in, Scalar* out, const MASK& mask, const Scalar* m)
+{
+	foreach_chunk_line(mask, [&] (uint32 i)
+	{
+		const Scalar* p = in + 3u * i;
+		const Scalar x = p[0], y = p[1], z = p[2];
+		Scalar* q = out + 3u * i;
+		q[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+		q[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+		q[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+	});
+}
+
+#if defined(__AVX__)
+
+// one position per 256 bits register (x,y,z,-)
+template <typename MASK>
+inline void transform_chunk_avx(const float64* in, float64* out, const MASK& mask, const float64* m)
+{
+	const __m256d c0 = _mm256_set_pd(0.0, m[2], m[1], m[0]);
+	const __m256d c1 = _mm256_set_pd(0.0, m[6], m[5], m[4]);
+	const __m256d c2 = _mm256_set_pd(0.0, m[10], m[9], m[8]);
+	const __m256d c3 = _mm256_set_pd(0.0, m[14], m[13], m[12]);
+	const __m256i xyz = _mm256_set_epi64x(0, -1, -1, -1);
+
+	foreach_chunk_line(mask, [&] (uint32 i)
+	{
+		const float64* p = in + 3u * i;
+		__m256d r = _mm256_add_pd(c3, _mm256_mul_pd(c0, _mm256_broadcast_sd(p)));
+		r = _mm256_add_pd(r, _mm256_mul_pd(c1, _mm256_broadcast_sd(p + 1)));
+		r = _mm256_add_pd(r, _mm256_mul_pd(c2, _mm256_broadcast_sd(p + 2)));
+		_mm256_maskstore_pd(out + 3u * i, xyz, r);
+	});
+}
+
+// one position per 128 bits register (x,y,z,-)
+template <typename MASK>
+inline void transform_chunk_avx(const float32* in, float32* out, const MASK& mask, const float32* m)
+{
+	const __m128 c0 = _mm_set_ps(0.0f, m[2], m[1], m[0]);
+	const __m128 c1 = _mm_set_ps(0.0f, m[6], m[5], m[4]);
+	const __m128 c2 = _mm_set_ps(0.0f, m[10], m[9], m[8]);
+	const __m128 c3 = _mm_set_ps(0.0f, m[14], m[13], m[12]);
+	const __m128i xyz = _mm_set_epi32(0, -1, -1, -1);
+
+	foreach_chunk_line(mask, [&] (uint32 i)
+	{
+		const float32* p = in + 3u * i;
+		__m128 r = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_broadcast_ss(p)));
+		r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_broadcast_ss(p + 1)));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_broadcast_ss(p + 2)));
+		_mm_maskstore_ps(out + 3u * i, xyz, r);
+	});
+}
+
+#endif // defined(__AVX__)
+
+#if defined(__AVX512F__)
+
+// two consecutive positions per 512 bits register, the lines that are not part of a used pair use the AVX kernel
+template <typename MASK>
+inline void transform_chunk_avx512(const float64* in, float64* out, const MASK& mask, const float64* m)
+{
+	const __m512d c0 = _mm512_set_pd(0.0, m[2], m[1], m[0], 0.0, m[2], m[1], m[0]);
+	const __m512d c1 = _mm512_set_pd(0.0, m[6], m[5], m[4], 0.0, m[6], m[5], m[4]);
+	const __m512d c2 = _mm512_set_pd(0.0, m[10], m[9], m[8], 0.0, m[10], m[9], m[8]);
+	const __m512d c3 = _mm512_set_pd(0.0, m[14], m[13], m[12], 0.0, m[14], m[13], m[12]);
+	const __m512i ix = _mm512_set_epi64(3, 3, 3, 3, 0, 0, 0, 0);
+	const __m512i iy = _mm512_set_epi64(4, 4, 4, 4, 1, 1, 1, 1);
+	const __m512i iz = _mm512_set_epi64(5, 5, 5, 5, 2, 2, 2, 2);
+
+	MASK remaining;
+	for (uint32 w = 0u; w < uint32(mask.size()); ++w)
+	{
+		uint64 bits = mask[w];
+		remaining[w] = 0u;
+		for (uint32 k = 0u; k < 64u && bits != 0u; k += 2u, bits >>= 2u)
+		{
+			if ((bits & 3u) != 3u)
+			{
+				remaining[w] |= (bits & 3u) << k;
+				continue;
+			}
+			const uint32 i = 64u * w + k;
+			const __m512d p = _mm512_maskz_loadu_pd(0x3F, in + 3u * i);
+			__m512d r = _mm512_add_pd(c3, _mm512_mul_pd(c0, _mm512_permutexvar_pd(ix, p)));
+			r = _mm512_add_pd(r, _mm512_mul_pd(c1, _mm512_permutexvar_pd(iy, p)));
+			r = _mm512_add_pd(r, _mm512_mul_pd(c2, _mm512_permutexvar_pd(iz, p)));
+			_mm512_mask_storeu_pd(out + 3u * i, 0x3F, _mm512_maskz_compress_pd(0x77, r));
+		}
+	}
+	transform_chunk_avx(in, out, remaining, m);
+}
+
+// four consecutive positions per 512 bits register, the lines that are not part of a used quadruple use the AVX kernel
+template <typename MASK>
+inline void transform_chunk_avx512(const float32* in, float32* out, const MASK& mask, const float32* m)
+{
+	const __m512 c0 = _mm512_set_ps(0.0f, m[2], m[1], m[0], 0.0f, m[2], m[1], m[0], 0.0f, m[2], m[1], m[0], 0.0f, m[2], m[1], m[0]);
+	const __m512 c1 = _mm512_set_ps(0.0f, m[6], m[5], m[4], 0.0f, m[6], m[5], m[4], 0.0f, m[6], m[5], m[4], 0.0f, m[6], m[5], m[4]);
+	const __m512 c2 = _mm512_set_ps(0.0f, m[10], m[9], m[8], 0.0f, m[10], m[9], m[8], 0.0f, m[10], m[9], m[8], 0.0f, m[10], m[9], m[8]);
+	const __m512 c3 = _mm512_set_ps(0.0f, m[14], m[13], m[12], 0.0f, m[14], m[13], m[12], 0.0f, m[14], m[13], m[12], 0.0f, m[14], m[13], m[12]);
+	const __m512i ix = _mm512_set_epi32(9, 9, 9, 9, 6, 6, 6, 6, 3, 3, 3, 3, 0, 0, 0, 0);
+	const __m512i iy = _mm512_set_epi32(10, 10, 10, 10, 7, 7, 7, 7, 4, 4, 4, 4, 1, 1, 1, 1);
+	const __m512i iz = _mm512_set_epi32(11, 11, 11, 11, 8, 8, 8, 8, 5, 5, 5, 5, 2, 2, 2, 2);
+
+	MASK remaining;
+	for (uint32 w = 0u; w < uint32(mask.size()); ++w)
+	{
+		uint64 bits = mask[w];
+		remaining[w] = 0u;
+		for (uint32 k = 0u; k < 64u && bits != 0u; k += 4u, bits >>= 4u)
+		{
+			if ((bits & 0xFu) != 0xFu)
+			{
+				remaining[w] |= (bits & 0xFu) << k;
+				continue;
+			}
+			const uint32 i = 64u * w + k;
+			const __m512 p = _mm512_maskz_loadu_ps(0x0FFF, in + 3u * i);
+			__m512 r = _mm512_add_ps(c3, _mm512_mul_ps(c0, _mm512_permutexvar_ps(ix, p)));
+			r = _mm512_add_ps(r, _mm512_mul_ps(c1, _mm512_permutexvar_ps(iy, p)));
+			r = _mm512_add_ps(r, _mm512_mul_ps(c2, _mm512_permutexvar_ps(iz, p)));
+			_mm512_mask_storeu_ps(out + 3u * i, 0x0FFF, _mm512_maskz_compress_ps(0x7777, r));
+		}
+	}
+	transform_chunk_avx(in, out, remaining, m);
+}
+
+#endif // defined(__AVX512F__)
+
+template <typename Scalar, typename MASK>
+inline void transform_chunk_raw(const Scalar* in, Scalar* out, const MASK& mask, const Scalar* m)
+{
+#if defined(__AVX512F__)
+	transform_chunk_avx512(in, out, mask, m);
+#elif defined(__AVX__)
+	transform_chunk_avx(in, out, mask, m);
+#else
+	transform_chunk_scalar(in, out, mask, m);
+#endif
+}
+
+// positions stored as 3 packed float32 or float64 : SIMD kernels
+template <typename VEC3, typename MASK>
+inline auto transform_chunk(const VEC3* in, VEC3* out, const MASK& mask, const typename vector_traits<VEC3>::Scalar* m)
+	-> typename std::enable_if<
+		sizeof(VEC3) == 3u * sizeof(typename vector_traits<VEC3>::Scalar) &&
+		(std::is_same<typename vector_traits<VEC3>::Scalar, float32>::value || std::is_same<typename vector_traits<VEC3>::Scalar, float64>::value)
+	>::type
+{
+	using Scalar = typename vector_traits<VEC3>::Scalar;
+	transform_chunk_raw(reinterpret_cast<const Scalar*>(in), reinterpret_cast<Scalar*>(out), mask, m);
+}
+
+// other layouts : element by element
+template <typename VEC3, typename MASK>
+inline auto transform_chunk(const VEC3* in, VEC3* out, const MASK& mask, const typename vector_traits<VEC3>::Scalar* m)
+	-> typename std::enable_if<!(
+		sizeof(VEC3) == 3u * sizeof(typename vector_traits<VEC3>::Scalar) &&
+		(std::is_same<typename vector_traits<VEC3>::Scalar, float32>::value || std::is_same<typename vector_traits<VEC3>::Scalar, float64>::value)
+	)>::type
+{
+	using Scalar = typename vector_traits<VEC3>::Scalar;
+	foreach_chunk_line(mask, [&] (uint32 i)
+	{
+		const Scalar x = in[i][0], y = in[i][1], z = in[i][2];
+		out[i][0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+		out[i][1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+		out[i][2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+	});
+}
+
+} // namespace internal
+
+/**
+ * @brief apply an affine transformation to the vertex positions, chunk by chunk and in parallel
+ * SIMD kernels (AVX-512 / AVX) are used for packed float32 or float64 positions when available.
+ * @param map the map
+ * @param pos_in input positions
+ * @param pos_out transformed positions (may be the same attribute as pos_in)
+ * @param matrix the transformation (only the upper 3x4 part is used, no projective division)
+ */
+template <typename VEC3, typename MAP>
+void transform_position(
+	const MAP& map,
+	const typename MAP::template VertexAttribute<VEC3>& pos_in,
+	typename MAP::template VertexAttribute<VEC3>& pos_out,
+	const Eigen::Matrix<typename vector_traits<VEC3>::Scalar, 4, 4>& matrix
+)
+{
+	using ChunkMask = typename MAP::template ChunkArrayContainer<uint32>::ChunkMask;
+
+	map.template attribute_container<MAP::Vertex::ORBIT>().parallel_foreach_chunk([&] (uint32 chunk, const ChunkMask& mask)
+	{
+		internal::transform_chunk(pos_in.chunk_data(chunk), pos_out.chunk_data(chunk), mask, matrix.data());
+	});
+}
+
+/**
+ * @brief apply an affine transformation to the vertex positions stored with a structure of arrays layout
+ * Each component chunk is processed as a whole (including its unused lines): the loop has no
+ * gather/scatter and is vectorized by the compiler.
+ * @param map the map
+ * @param pos_in input positions
+ * @param pos_out transformed positions (may be the same attribute as pos_in)
+ * @param matrix the transformation (only the upper 3x4 part is used, no projective division)
+ */
+template <typename VEC3, typename MAP>
+void transform_position(
+	const MAP& map,
+	const AttributeSoA<VEC3, MAP::Vertex::ORBIT>& pos_in,
+	AttributeSoA<VEC3, MAP::Vertex::ORBIT>& pos_out,
+	const Eigen::Matrix<typename vector_traits<VEC3>::Scalar, 4, 4>& matrix
+)
+{
+	using Scalar = typename vector_traits<VEC3>::Scalar;
+	using ChunkMask = typename MAP::template ChunkArrayContainer<uint32>::ChunkMask;
+
+	const Scalar* m = matrix.data();
+	map.template attribute_container<MAP::Vertex::ORBIT>().parallel_foreach_chunk([&] (uint32 chunk, const ChunkMask&)
+	{
+		const Scalar* x = pos_in.chunk_data(chunk, 0u);
+		const Scalar* y = pos_in.chunk_data(chunk, 1u);
+		const Scalar* z = pos_in.chunk_data(chunk, 2u);
+		Scalar* ox = pos_out.chunk_data(chunk, 0u);
+		Scalar* oy = pos_out.chunk_data(chunk, 1u);
+		Scalar* oz = pos_out.chunk_data(chunk, 2u);
+		for (uint32 i = 0u; i < MAP::CHUNK_SIZE; ++i)
+		{
+			const Scalar px = x[i], py = y[i], pz = z[i];
+			ox[i] = m[0] * px + m[4] * py + m[8] * pz + m[12];
+			oy[i] = m[1] * px + m[5] * py + m[9] * pz + m[13];
+			oz[i] = m[2] * px + m[6] * py + m[10] * pz + m[14];
+		}
+	});
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_TRANSFORM_H_
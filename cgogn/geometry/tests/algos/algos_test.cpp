@@ -27,8 +27,13 @@
 #include <cgogn/geometry/types/vec.h>
 #include <cgogn/geometry/algos/area.h>
 #include <cgogn/geometry/algos/centroid.h>
+#include <cgogn/geometry/algos/length.h>
+#include <cgogn/geometry/algos/bounding_box.h>
+#include <cgogn/geometry/algos/transform.h>
+#include <cgogn/geometry/algos/filtering.h>
 #include <cgogn/geometry/algos/normal.h>
 #include <cgogn/geometry/algos/ear_triangulation.h>
+#include <cgogn/geometry/algos/space_filling_curve.h>
 
 #include <cgogn/io/map_import.h>
 
@@ -128,6 +133,196 @@ TYPED_TEST(Algos_TEST, QuadCentroid)
 	EXPECT_TRUE(cgogn::almost_equal_absolute(centroid[2], Scalar(0)));
 }
 
+TYPED_TEST(Algos_TEST, MapReductions)
+{
+	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
+	VertexAttribute<TypeParam> vertex_position = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position");
+	this->add_polygone(4);
+
+	const Scalar mean_length = cgogn::geometry::mean_edge_length<TypeParam>(this->map2_, vertex_position);
+	EXPECT_TRUE(cgogn::almost_equal_relative(mean_length, Scalar(std::sqrt(2.0)), Scalar(1e-5)));
+
+	const TypeParam centroid = cgogn::geometry::centroid<TypeParam>(this->map2_, vertex_position);
+	EXPECT_TRUE(cgogn::almost_equal_absolute(centroid[0], Scalar(0), Scalar(1e-5)));
+	EXPECT_TRUE(cgogn::almost_equal_absolute(centroid[1], Scalar(0), Scalar(1e-5)));
+	EXPECT_TRUE(cgogn::almost_equal_absolute(centroid[2], Scalar(0), Scalar(1e-5)));
+
+	cgogn::geometry::AABB<TypeParam> bb;
+	cgogn::geometry::compute_AABB(vertex_position, this->map2_, bb);
+	EXPECT_TRUE(bb.is_initialized());
+	EXPECT_TRUE(cgogn::almost_equal_absolute(bb.min()[0], Scalar(-1), Scalar(1e-5)));
+	EXPECT_TRUE(cgogn::almost_equal_absolute(bb.min()[1], Scalar(-1), Scalar(1e-5)));
+	EXPECT_TRUE(cgogn::almost_equal_absolute(bb.max()[0], Scalar(1), Scalar(1e-5)));
+	EXPECT_TRUE(cgogn::almost_equal_absolute(bb.max()[1], Scalar(1), Scalar(1e-5)));
+}
+
+TYPED_TEST(Algos_TEST, TransformPosition)
+{
+	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
+	using Matrix = Eigen::Matrix<Scalar, 4, 4>;
+	VertexAttribute<TypeParam> vertex_position = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position");
+	VertexAttribute<TypeParam> vertex_position2 = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position2");
+	for (uint32 i = 0u; i < 10u; ++i)
+		this->add_polygone(4u + i);
+	// create some holes in the vertex container
+	std::vector<CMap2::Volume> polygons;
+	this->map2_.foreach_cell([&] (CMap2::Volume w) { polygons.push_back(w); });
+	this->map2_.remove_volume(polygons[1]);
+	this->map2_.remove_volume(polygons[6]);
+
+	Matrix m;
+	m << Scalar(0), Scalar(-2), Scalar(0), Scalar(1),
+		 Scalar(1), Scalar(0), Scalar(0), Scalar(2),
+		 Scalar(0), Scalar(0), Scalar(3), Scalar(3),
+		 Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+
+	cgogn::geometry::transform_position<TypeParam>(this->map2_, vertex_position, vertex_position2, m);
+	this->map2_.foreach_cell([&] (Vertex v)
+	{
+		const TypeParam& p = vertex_position[v];
+		const TypeParam& q = vertex_position2[v];
+		EXPECT_TRUE(cgogn::almost_equal_absolute(q[0], Scalar(1) - Scalar(2) * p[1], Scalar(1e-5)));
+		EXPECT_TRUE(cgogn::almost_equal_absolute(q[1], Scalar(2) + p[0], Scalar(1e-5)));
+		EXPECT_TRUE(cgogn::almost_equal_absolute(q[2], Scalar(3) + Scalar(3) * p[2], Scalar(1e-5)));
+	});
+
+	// in place
+	cgogn::geometry::transform_position<TypeParam>(this->map2_, vertex_position, vertex_position, m);
+	this->map2_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_TRUE(cgogn::almost_equal_absolute(vertex_position[v][0], vertex_position2[v][0], Scalar(1e-5)));
+		EXPECT_TRUE(cgogn::almost_equal_absolute(vertex_position[v][1], vertex_position2[v][1], Scalar(1e-5)));
+		EXPECT_TRUE(cgogn::almost_equal_absolute(vertex_position[v][2], vertex_position2[v][2], Scalar(1e-5)));
+	});
+}
+
+TYPED_TEST(Algos_TEST, SoAKernels)
+{
+	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
+	using Matrix = Eigen::Matrix<Scalar, 4, 4>;
+	using VertexAttributeSoA = cgogn::AttributeSoA<TypeParam, Vertex::ORBIT>;
+	VertexAttribute<TypeParam> vertex_position = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position");
+	VertexAttribute<TypeParam> vertex_position2 = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position2");
+	VertexAttributeSoA soa_position = this->map2_.template add_soa_attribute<TypeParam, CMap2::Vertex>("soa_position");
+	VertexAttributeSoA soa_position2 = this->map2_.template add_soa_attribute<TypeParam, CMap2::Vertex>("soa_position2");
+	for (uint32 i = 0u; i < 10u; ++i)
+		this->add_polygone(4u + i);
+	this->map2_.foreach_cell([&] (Vertex v) { soa_position[v] = vertex_position[v]; });
+
+	Matrix m;
+	m << Scalar(0), Scalar(-2), Scalar(0), Scalar(1),
+		 Scalar(1), Scalar(0), Scalar(0), Scalar(2),
+		 Scalar(0), Scalar(0), Scalar(3), Scalar(3),
+		 Scalar(0), Scalar(0), Scalar(0), Scalar(1);
+
+	cgogn::geometry::transform_position<TypeParam>(this->map2_, vertex_position, vertex_position2, m);
+	cgogn::geometry::transform_position<TypeParam>(this->map2_, soa_position, soa_position2, m);
+	this->map2_.foreach_cell([&] (Vertex v)
+	{
+		const TypeParam p = soa_position2[v];
+		for (uint32 k = 0u; k < 3u; ++k)
+			EXPECT_TRUE(cgogn::almost_equal_absolute(p[k], vertex_position2[v][k], Scalar(1e-5)));
+	});
+
+	cgogn::geometry::filter_average<TypeParam>(this->map2_, vertex_position2, vertex_position);
+	cgogn::geometry::filter_average<TypeParam>(this->map2_, soa_position2, soa_position);
+	this->map2_.foreach_cell([&] (Vertex v)
+	{
+		const TypeParam p = soa_position[v];
+		for (uint32 k = 0u; k < 3u; ++k)
+			EXPECT_TRUE(cgogn::almost_equal_absolute(p[k], vertex_position[v][k], Scalar(1e-5)));
+	});
+}
+
+TEST(SpaceFillingCurve, Keys)
+{
+	using cgogn::geometry::SpaceFillingCurve;
+	using cgogn::geometry::internal::curve_key;
+
+	// the Hilbert curve goes from a cell of the grid to a neighbor one
+	std::vector<std::pair<uint64, std::array<uint32, 2>>> cells2;
+	for (uint32 x = 0u; x < 8u; ++x)
+		for (uint32 y = 0u; y < 8u; ++y)
+			cells2.emplace_back(curve_key<2>({{x, y}}, 3u, SpaceFillingCurve::HILBERT), std::array<uint32, 2>{{x, y}});
+	std::sort(cells2.begin(), cells2.end());
+	for (uint32 i = 0u; i < 64u; ++i)
+	{
+		EXPECT_EQ(cells2[i].first, i);
+		if (i > 0u)
+		{
+			const uint32 dist = uint32(std::abs(int32(cells2[i].second[0]) - int32(cells2[i-1u].second[0]))
+				+ std::abs(int32(cells2[i].second[1]) - int32(cells2[i-1u].second[1])));
+			EXPECT_EQ(dist, 1u);
+		}
+	}
+
+	std::vector<std::pair<uint64, std::array<uint32, 3>>> cells3;
+	for (uint32 x = 0u; x < 4u; ++x)
+		for (uint32 y = 0u; y < 4u; ++y)
+			for (uint32 z = 0u; z < 4u; ++z)
+				cells3.emplace_back(curve_key<3>({{x, y, z}}, 2u, SpaceFillingCurve::HILBERT), std::array<uint32, 3>{{x, y, z}});
+	std::sort(cells3.begin(), cells3.end());
+	for (uint32 i = 0u; i < 64u; ++i)
+	{
+		EXPECT_EQ(cells3[i].first, i);
+		if (i > 0u)
+		{
+			uint32 dist = 0u;
+			for (uint32 k = 0u; k < 3u; ++k)
+				dist += uint32(std::abs(int32(cells3[i].second[k]) - int32(cells3[i-1u].second[k])));
+			EXPECT_EQ(dist, 1u);
+		}
+	}
+
+	// Morton: interleaved bits
+	EXPECT_EQ(curve_key<2>({{1u, 0u}}, 3u, SpaceFillingCurve::MORTON), 2u);
+	EXPECT_EQ(curve_key<2>({{3u, 5u}}, 3u, SpaceFillingCurve::MORTON), 27u);
+}
+
+TYPED_TEST(Algos_TEST, ReorderAlongCurve)
+{
+	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
+	VertexAttribute<TypeParam> vertex_position = this->map2_.template add_attribute<TypeParam, CMap2::Vertex>("position");
+	for (uint32 i = 0u; i < 20u; ++i)
+	{
+		const Face f = this->map2_.add_face(3 + i % 4u);
+		uint32 j = 0u;
+		this->map2_.foreach_incident_vertex(f, [&] (Vertex v)
+		{
+			vertex_position[v] = TypeParam(Scalar((i * 7u) % 20u), Scalar(j++), Scalar(i % 3u));
+		});
+	}
+
+	// positions of the vertices of each face, in the order of the face (starting from the smallest one)
+	auto faces = [&] ()
+	{
+		std::vector<std::vector<std::array<Scalar, 3>>> result;
+		this->map2_.foreach_cell([&] (Face f)
+		{
+			std::vector<std::array<Scalar, 3>> coords;
+			this->map2_.foreach_incident_vertex(f, [&] (Vertex v)
+			{
+				const TypeParam& p = vertex_position[v];
+				coords.push_back({{p[0], p[1], p[2]}});
+			});
+			std::rotate(coords.begin(), std::min_element(coords.begin(), coords.end()), coords.end());
+			result.push_back(coords);
+		});
+		std::sort(result.begin(), result.end());
+		return result;
+	};
+	const std::vector<std::vector<std::array<Scalar, 3>>> reference = faces();
+
+	cgogn::geometry::reorder_along_curve<TypeParam>(this->map2_, vertex_position);
+	EXPECT_TRUE(this->map2_.check_map_integrity());
+	EXPECT_TRUE(faces() == reference);
+
+	// the vertices are stored along the curve
+	const std::vector<uint32> order = cgogn::geometry::space_filling_curve_order(vertex_position);
+	for (uint32 i = 0u; i < order.size(); ++i)
+		EXPECT_EQ(order[i], i);
+}
+
 TYPED_TEST(Algos_TEST, TriangleNormal)
 {
 	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
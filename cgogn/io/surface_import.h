@@ -173,18 +173,15 @@ public:
 		if (face_container().nb_chunk_arrays() > 0)
 			mbuild_.template create_embedding<Face::ORBIT>();
 
-		auto darts_per_vertex = map_.template add_attribute<std::vector<Dart>, Vertex>("darts_per_vertex");
-
-		uint32 faces_vertex_index = 0;
-		std::vector<uint32> vertices_buffer;
-		vertices_buffer.reserve(16);
-		uint32 face_emb = 0u;
-
+		// the faces are compacted in place: consecutive duplicated vertices are removed
+		// and the faces that have less than 3 vertices are skipped
+		uint32 nb_kept_faces = 0u;
+		uint32 nb_kept_indices = 0u;
+		uint32 faces_vertex_index = 0u;
 		for (uint32 i = 0, end = nb_faces(); i < end; ++i)
 		{
-			uint32 nbe = this->faces_nb_edges_[i];
-
-			vertices_buffer.clear();
+			const uint32 nbe = this->faces_nb_edges_[i];
+			const uint32 first = nb_kept_indices;
 			uint32 prev = std::numeric_limits<uint32>::max();
 
 			for (uint32 j = 0; j < nbe; ++j)
@@ -193,64 +190,22 @@ public:
 				if (idx != prev)
 				{
 					prev = idx;
-					vertices_buffer.push_back(idx);
+					this->faces_vertex_indices_[nb_kept_indices++] = idx;
 				}
 			}
-			if (vertices_buffer.front() == vertices_buffer.back())
-				vertices_buffer.pop_back();
+			if (nb_kept_indices > first && this->faces_vertex_indices_[first] == this->faces_vertex_indices_[nb_kept_indices - 1u])
+				--nb_kept_indices;
 
-			nbe = static_cast<unsigned short>(vertices_buffer.size());
-			if (nbe > 2)
-			{
-				Dart d = mbuild_.add_face_topo_fp(nbe);
-				for (uint32 j = 0u; j < nbe; ++j)
-				{
-					const uint32 vertex_index = vertices_buffer[j];
-					mbuild_.template set_embedding<Vertex>(d, vertex_index);
-					darts_per_vertex[vertex_index].push_back(d);
-					d = map_.phi1(d);
-				}
-				if (map_.is_embedded(Face::ORBIT))
-					mbuild_.template set_orbit_embedding<Face>(Face(d), face_emb++);
-			}
+			if (nb_kept_indices - first > 2u)
+				this->faces_nb_edges_[nb_kept_faces++] = nb_kept_indices - first;
+			else
+				nb_kept_indices = first;
 		}
+		this->faces_nb_edges_.resize(nb_kept_faces);
+		this->faces_vertex_indices_.resize(nb_kept_indices);
 
 		bool need_vertex_unicity_check = false;
-		uint32 nb_boundary_edges = 0;
-
-		map_.foreach_dart([&] (Dart d)
-		{
-			if (map_.phi2(d) == d)
-			{
-				uint32 vertex_index = map_.embedding(Vertex(d));
-
-				std::vector<Dart>& next_vertex_darts = darts_per_vertex[Vertex(map_.phi1(d))];
-				bool phi2_found = false;
-				bool first_OK = true;
-
-				for (auto it = next_vertex_darts.begin();
-					 it != next_vertex_darts.end() && !phi2_found;
-					 ++it)
-				{
-					if (map_.embedding(Vertex(map_.phi1(*it))) == vertex_index)
-					{
-						if (map_.phi2(*it) == *it)
-						{
-							mbuild_.phi2_sew(d, *it);
-							phi2_found = true;
-						}
-						else
-							first_OK = false;
-					}
-				}
-
-				if (!phi2_found)
-					++nb_boundary_edges;
-
-				if (!first_OK)
-					need_vertex_unicity_check = true;
-			}
-		});
+		const uint32 nb_boundary_edges = mbuild_.add_faces_bulk(this->faces_nb_edges_, this->faces_vertex_indices_, need_vertex_unicity_check);
 
 		if (nb_boundary_edges > 0)
 		{
@@ -264,8 +219,6 @@ public:
 			cgogn_log_warning("create_map") << "Import Surface: non manifold vertices detected and corrected";
 		}
 
-		map_.remove_attribute(darts_per_vertex);
-
 		cgogn_assert(map_.template is_well_embedded<Vertex>());
 		if (map_.template is_embedded<Face::ORBIT>())
 		{
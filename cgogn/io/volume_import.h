@@ -26,8 +26,13 @@
 
 #include <istream>
 #include <set>
+#include <array>
+#include <atomic>
+#include <algorithm>
 
 #include <cgogn/core/utils/string.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/utils/parallel_sort.h>
 
 #include <cgogn/core/cmap/cmap3.h>
 
@@ -265,17 +270,29 @@ public:
 		if (volume_container().nb_chunk_arrays() > 0)
 			mbuild_.template create_embedding<Volume::ORBIT>();
 
-		auto darts_per_vertex = map_.template add_attribute<std::vector<Dart>, Vertex>("darts_per_vertex");
+		// topology: all the chunks of the darts are allocated at once
+		uint32 nb_darts = 0u;
+		for (const VolumeType vol_type : this->volumes_types_)
+			nb_darts += nb_darts_of_volume(vol_type);
+		mbuild_.reserve_darts(nb_darts);
 
 		uint32 index = 0u;
-		typename MAP::DartMarker dart_marker(map_);
 		Dart d;
 		uint32 vol_emb = 0u;
+		std::vector<Dart> volumes;
+		std::vector<uint32> volumes_faces_offsets(1u, 0u);
+		volumes.reserve(this->nb_volumes());
+		volumes_faces_offsets.reserve(this->nb_volumes() + 1u);
+
+		auto embed_vertices = [&] (const Dart* vertices, uint32 nb_vertices)
+		{
+			for (uint32 j = 0u; j < nb_vertices; ++j)
+				mbuild_.template set_orbit_embedding<Vertex>(Vertex2(vertices[j]), this->volumes_vertex_indices_[index++]);
+		};
 
 		// for each volume of table
 		for (uint32 i = 0u, end = this->nb_volumes(); i < end; ++i)
 		{
-			// store volume in buffer, removing degenated faces
 			const VolumeType vol_type = this->volumes_types_[i];
 
 			if (vol_type == VolumeType::Tetra) // tetrahedral case
@@ -291,20 +308,7 @@ public:
 					map_.phi_1(d),
 					map_.phi_1(map_.phi2(map_.phi_1(d)))
 				};
-
-				for (const Dart& dv : vertices_of_tetra)
-				{
-					const uint32 emb = this->volumes_vertex_indices_[index++];
-					mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), emb);
-
-					Dart dd = dv;
-					do
-					{
-						dart_marker.mark(dd);
-						darts_per_vertex[emb].push_back(dd);
-						dd = map_.phi1(map_.phi2(dd));
-					} while(dd != dv);
-				}
+				embed_vertices(vertices_of_tetra.data(), 4u);
 			}
 			else if (vol_type == VolumeType::Pyramid) // pyramidal case
 			{
@@ -320,20 +324,7 @@ public:
 					map_.phi_1(d),
 					map_.phi_1(map_.phi2(map_.phi_1(d)))
 				};
-
-				for (Dart dv : vertices_of_pyramid)
-				{
-					const uint32 emb = this->volumes_vertex_indices_[index++];
-					mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), emb);
-
-					Dart dd = dv;
-					do
-					{
-						dart_marker.mark(dd);
-						darts_per_vertex[emb].push_back(dd);
-						dd = map_.phi1(map_.phi2(dd));
-					} while(dd != dv);
-				}
+				embed_vertices(vertices_of_pyramid.data(), 5u);
 			}
 			else if (vol_type == VolumeType::TriangularPrism) // prism case
 			{
@@ -350,20 +341,7 @@ public:
 					map_.phi2(map_.phi1(map_.phi1(map_.phi2(d)))),
 					map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(d)))))
 				};
-
-				for (Dart dv : vertices_of_prism)
-				{
-					const uint32 emb = this->volumes_vertex_indices_[index++];
-					mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), emb);
-
-					Dart dd = dv;
-					do
-					{
-						dart_marker.mark(dd);
-						darts_per_vertex[emb].push_back(dd);
-						dd = map_.phi1(map_.phi2(dd));
-					} while(dd != dv);
-				}
+				embed_vertices(vertices_of_prism.data(), 6u);
 			}
 			else if (vol_type == VolumeType::Hexa) // hexahedral case
 			{
@@ -382,20 +360,7 @@ public:
 					map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(d))))),
 					map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(map_.phi1(d))))))
 				};
-
-				for (Dart dv : vertices_of_hexa)
-				{
-					const uint32 emb = this->volumes_vertex_indices_[index++];
-					mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), emb);
-
-					Dart dd = dv;
-					do
-					{
-						dart_marker.mark(dd);
-						darts_per_vertex[emb].push_back(dd);
-						dd = map_.phi1(map_.phi2(dd));
-					} while(dd != dv);
-				}
+				embed_vertices(vertices_of_hexa.data(), 8u);
 			}
 			else //end of hexa
 			{
@@ -405,153 +370,183 @@ public:
 					// The second part of the code generates connectors automatically. We don't have to do anything here.
 				}
 			}
+
+			if (vol_type != VolumeType::Connector)
+			{
+				volumes.push_back(d);
+				volumes_faces_offsets.push_back(volumes_faces_offsets.back() + nb_faces_of_volume(vol_type));
+			}
 			if (map_.is_embedded(Volume::ORBIT))
 				mbuild_.template set_orbit_embedding<Volume>(Volume(d), vol_emb++);
 		}
 
-		// reconstruct neighbourhood
-		uint32 nb_boundary_faces = 0u;
-
-		map_.foreach_dart([&] (Dart d)
+		// reconstruct neighbourhood:
+		// the faces of the volumes are sorted by their (sorted) vertex indices, the faces with the same vertices are consecutive
+		struct FaceKey
+		{
+			std::array<uint32, 4> vertices_; // INVALID_INDEX after the vertices of a triangle
+			uint32 dart_;
+		};
+		const uint32 nb_faces = volumes_faces_offsets.back();
+		std::vector<FaceKey> keys(nb_faces);
+		parallel_foreach_index(uint32(volumes.size()), [&] (uint32 i)
 		{
-			if (dart_marker.is_marked(d))
+			uint32 k = volumes_faces_offsets[i];
+			map_.foreach_incident_face(Volume(volumes[i]), [&] (Face f)
 			{
-				Dart good_dart;
-
-				// 1st step : for every dart of the face we try to find a valid phi3 candidate. If we can't it's a boundary face.
+				cgogn_assert(k < volumes_faces_offsets[i + 1u]);
+				FaceKey& key = keys[k++];
+				key.vertices_.fill(INVALID_INDEX);
+				key.dart_ = f.dart.index;
+				uint32 n = 0u;
+				Dart it = f.dart;
+				do
 				{
-					Dart d_it = d;
-					do
-					{
-						const std::vector<Dart>& vec = darts_per_vertex[Vertex(map_.phi1(d_it))];
-						for (auto it = vec.begin(); it != vec.end() && good_dart.is_nil(); ++it)
-						{
-							if (map_.embedding(Vertex(map_.phi1(*it))) == map_.embedding(Vertex(d_it)) &&
-								map_.embedding(Vertex(map_.phi_1(*it))) == map_.embedding(Vertex(map_.phi1(map_.phi1(d_it)))))
-							{
-								good_dart = *it;
-							}
-						}
-						d_it = map_.phi1(d_it);
-					} while (good_dart.is_nil() && (d_it != d));
-					d = map_.phi_1(d_it);
-				}
+					key.vertices_[n++] = map_.embedding(Vertex(it));
+					it = map_.phi1(it);
+				} while (it != f.dart && n < 4u);
+				std::sort(key.vertices_.begin(), key.vertices_.begin() + n);
+			});
+		});
+		parallel_sort(keys.begin(), keys.end(), [] (const FaceKey& a, const FaceKey& b)
+		{
+			return a.vertices_ < b.vertices_ || (a.vertices_ == b.vertices_ && a.dart_ < b.dart_);
+		});
 
-				if (!good_dart.is_nil()) //not a boundary faces
+		// the dart of the face of e that goes from the vertex of phi1(d) to the vertex of d (nil if the faces have the same orientation)
+		auto opposite_dart = [&] (Dart d, Dart e) -> Dart
+		{
+			const uint32 v0 = map_.embedding(Vertex(d));
+			const uint32 v1 = map_.embedding(Vertex(map_.phi1(d)));
+			Dart it = e;
+			do
+			{
+				if (map_.embedding(Vertex(it)) == v1 && map_.embedding(Vertex(map_.phi1(it))) == v0)
+					return it;
+				it = map_.phi1(it);
+			} while (it != e);
+			return Dart();
+		};
+
+		// the two first faces of a group that have opposite orientations are sewn
+		std::vector<uint8> unmatched(nb_faces, 0u);
+		parallel_foreach_index(nb_faces, [&] (uint32 k)
+		{
+			if (k > 0u && keys[k - 1u].vertices_ == keys[k].vertices_)
+				return;
+			uint32 end = k + 1u;
+			while (end < nb_faces && keys[end].vertices_ == keys[k].vertices_)
+				++end;
+
+			uint32 first_unmatched = k;
+			if (end - k > 1u)
+			{
+				const Dart good_dart = opposite_dart(Dart(keys[k].dart_), Dart(keys[k + 1u].dart_));
+				if (!good_dart.is_nil())
 				{
-					const uint32 degD = map_.codegree(Face(d));
-					const uint32 degGD = map_.codegree(Face(good_dart));
-
-					if (degD == degGD) // normal case : the two opposite faces have the same degree
-					{
-						mbuild_.sew_volumes_fp(d, good_dart);
-						dart_marker.unmark_orbit(Face(d));
-					}
-					else
-					{
-						// there is one face of degree 4 and one face of degree 3.
-						if (degD > degGD) // face of d is quad
-						{
-							const Dart another_d = map_.phi1(map_.phi1(d));
-							const std::vector<Dart>& vec = darts_per_vertex[Vertex(map_.phi_1(d))];
-
-							Dart another_good_dart;
-							for (auto it = vec.begin(); it != vec.end() && another_good_dart.is_nil(); ++it)
-							{
-								if (map_.embedding(Vertex(map_.phi1(*it))) == map_.embedding(Vertex(another_d)) &&
-									map_.embedding(Vertex(map_.phi_1(*it))) == map_.embedding(Vertex(map_.phi1(map_.phi1(another_d)))))
-								{
-									another_good_dart = *it ;
-								}
-							}
-
-							// we add a stamp volume between the faces
-							const Dart d_quad = mbuild_.add_stamp_volume_topo_fp();
-							{
-								if (map_.is_embedded(Volume::ORBIT))
-									mbuild_. new_orbit_embedding(Volume(d_quad));
-								Dart q1_it = d;
-								Dart q2_it = map_.phi_1(d_quad);
-								do
-								{
-									mbuild_.template set_orbit_embedding<Vertex>(Vertex2(q2_it), map_.embedding(Vertex(q1_it)));
-									q1_it = map_.phi1(q1_it);
-									q2_it = map_.phi_1(q2_it);
-								} while (q1_it != d);
-							}
-
-							mbuild_.sew_volumes_fp(d, map_.phi1(map_.phi1(d_quad)));
-							dart_marker.unmark_orbit(Face(d));
-
-							mbuild_.sew_volumes_fp(good_dart, map_.phi2(map_.phi1(map_.phi1(d_quad))));
-							dart_marker.unmark_orbit(Face(good_dart));
-
-							if (!another_good_dart.is_nil())
-							{
-								mbuild_.sew_volumes_fp(another_good_dart, map_.phi2(d_quad));
-								dart_marker.unmark_orbit(Face(another_good_dart));
-							}
-							else
-							{
-								dart_marker.unmark_orbit(Face2(map_.phi2(d_quad)));
-								++nb_boundary_faces;
-							}
-						}
-						else // face of d is tri
-						{
-							const Dart another_dart = map_.phi_1(d);
-							std::vector<Dart>& vec = darts_per_vertex[Vertex(d)];
-
-							Dart another_good_dart;
-							for (auto it = vec.begin(); it != vec.end() && another_good_dart.is_nil(); ++it)
-							{
-								if (map_.embedding(Vertex(map_.phi1(*it))) == map_.embedding(Vertex(another_dart)) &&
-									map_.embedding(Vertex(map_.phi_1(*it))) == map_.embedding(Vertex(map_.phi1(map_.phi1(good_dart)))))
-								{
-									another_good_dart = *it ;
-								}
-							}
-
-							const Dart d_quad = mbuild_.add_stamp_volume_topo_fp();
-							{
-								if (map_.is_embedded(Volume::ORBIT))
-									mbuild_.new_orbit_embedding(Volume(d_quad));
-								Dart q1_it = good_dart;
-								Dart q2_it = d_quad;
-								do
-								{
-									mbuild_.template set_orbit_embedding<Vertex>(Vertex2(q2_it), map_.embedding(Vertex(q1_it)));
-									q1_it = map_.phi1(q1_it);
-									q2_it = map_.phi_1(q2_it);
-								} while (q1_it != good_dart);
-							}
-
-							mbuild_.sew_volumes_fp(d_quad, map_.phi_1(good_dart));
-							dart_marker.unmark_orbit(Face(good_dart));
-
-							mbuild_.sew_volumes_fp(d, map_.phi2(map_.phi_1(d_quad)));
-							dart_marker.unmark_orbit(Face(d));
-
-							if (!another_good_dart.is_nil())
-							{
-								mbuild_.sew_volumes_fp(another_good_dart, map_.phi1(map_.phi2(map_.phi1(d_quad))));
-								dart_marker.unmark_orbit(Face(another_good_dart));
-							}
-							else
-							{
-								dart_marker.unmark_orbit(Face2(map_.phi1(map_.phi2(map_.phi1(d_quad)))));
-								++nb_boundary_faces;
-							}
-						}
-					}
+					mbuild_.sew_volumes_fp(Dart(keys[k].dart_), good_dart);
+					first_unmatched = k + 2u;
 				}
+			}
+			for (uint32 j = first_unmatched; j < end; ++j)
+				unmatched[j] = 1u;
+		});
+
+		// a quad face may be opposite to two triangle faces: a stamp volume is inserted between them
+		std::vector<uint32> unmatched_quads;
+		std::vector<FaceKey> unmatched_triangles;
+		for (uint32 k = 0u; k < nb_faces; ++k)
+		{
+			if (unmatched[k])
+			{
+				if (keys[k].vertices_[3] != INVALID_INDEX)
+					unmatched_quads.push_back(k);
 				else
+					unmatched_triangles.push_back(keys[k]);
+			}
+		}
+
+		uint32 nb_boundary_faces = uint32(unmatched_quads.size() + unmatched_triangles.size());
+
+		std::vector<uint8> triangle_used(unmatched_triangles.size(), 0u);
+		// an unmatched triangle opposite to the corner (d, phi1(d), phi1(phi1(d))) of a quad
+		auto find_triangle = [&] (Dart d) -> Dart
+		{
+			FaceKey key;
+			key.vertices_ = {{
+				map_.embedding(Vertex(d)),
+				map_.embedding(Vertex(map_.phi1(d))),
+				map_.embedding(Vertex(map_.phi1(map_.phi1(d)))),
+				INVALID_INDEX
+			}};
+			std::sort(key.vertices_.begin(), key.vertices_.begin() + 3);
+			auto it = std::lower_bound(unmatched_triangles.begin(), unmatched_triangles.end(), key, [] (const FaceKey& a, const FaceKey& b)
+			{
+				return a.vertices_ < b.vertices_;
+			});
+			for (; it != unmatched_triangles.end() && it->vertices_ == key.vertices_; ++it)
+			{
+				const std::size_t t = std::size_t(it - unmatched_triangles.begin());
+				if (triangle_used[t])
+					continue;
+				const Dart good_dart = opposite_dart(d, Dart(it->dart_));
+				if (!good_dart.is_nil())
 				{
-					dart_marker.unmark_orbit(Face2(d));
-					++nb_boundary_faces;
+					triangle_used[t] = 1u;
+					return good_dart;
 				}
 			}
-		});
+			return Dart();
+		};
+
+		for (const uint32 q : unmatched_quads)
+		{
+			if (unmatched_triangles.empty())
+				break;
+
+			const Dart quad(keys[q].dart_);
+			Dart d = quad;
+			Dart good_dart;
+			do
+			{
+				good_dart = find_triangle(d);
+				if (!good_dart.is_nil())
+					break;
+				d = map_.phi1(d);
+			} while (d != quad);
+
+			if (good_dart.is_nil())
+				continue;
+
+			const Dart another_good_dart = find_triangle(map_.phi1(map_.phi1(d)));
+
+			// we add a stamp volume between the faces
+			const Dart d_quad = mbuild_.add_stamp_volume_topo_fp();
+			{
+				if (map_.is_embedded(Volume::ORBIT))
+					mbuild_. new_orbit_embedding(Volume(d_quad));
+				Dart q1_it = d;
+				Dart q2_it = map_.phi_1(d_quad);
+				do
+				{
+					mbuild_.template set_orbit_embedding<Vertex>(Vertex2(q2_it), map_.embedding(Vertex(q1_it)));
+					q1_it = map_.phi1(q1_it);
+					q2_it = map_.phi_1(q2_it);
+				} while (q1_it != d);
+			}
+
+			mbuild_.sew_volumes_fp(d, map_.phi1(map_.phi1(d_quad)));
+			mbuild_.sew_volumes_fp(good_dart, map_.phi2(map_.phi1(map_.phi1(d_quad))));
+			nb_boundary_faces -= 2u;
+
+			if (!another_good_dart.is_nil())
+			{
+				mbuild_.sew_volumes_fp(another_good_dart, map_.phi2(d_quad));
+				--nb_boundary_faces;
+			}
+			else
+				++nb_boundary_faces; // the other triangle of the stamp volume
+		}
 
 		if (nb_boundary_faces > 0)
 		{
@@ -561,8 +556,6 @@ public:
 
 		map_.template enforce_unique_orbit_embedding<Vertex::ORBIT>();
 
-		map_.remove_attribute(darts_per_vertex);
-
 		cgogn_assert(map_.template is_well_embedded<Vertex>());
 		if (map_.template is_embedded<Volume::ORBIT>())
 		{
@@ -572,6 +565,30 @@ public:
 
 protected:
 
+	static inline uint32 nb_darts_of_volume(VolumeType vol_type)
+	{
+		switch (vol_type)
+		{
+			case VolumeType::Tetra: return 12u;
+			case VolumeType::Pyramid: return 16u;
+			case VolumeType::TriangularPrism: return 18u;
+			case VolumeType::Hexa: return 24u;
+			default: return 0u;
+		}
+	}
+
+	static inline uint32 nb_faces_of_volume(VolumeType vol_type)
+	{
+		switch (vol_type)
+		{
+			case VolumeType::Tetra: return 4u;
+			case VolumeType::Pyramid: return 5u;
+			case VolumeType::TriangularPrism: return 5u;
+			case VolumeType::Hexa: return 6u;
+			default: return 0u;
+		}
+	}
+
 	template <typename T>
 	inline void reorient_hexa(const ChunkArray<T>& pos, uint32& p0, uint32& p1, uint32& p2, uint32& p3, uint32& p4, uint32& p5, uint32& p6, uint32& p7)
 	{
@@ -32,6 +32,7 @@
 
 #include <cgogn/core/cmap/cmap2.h>
 #include <cgogn/core/utils/masks.h>
+#include <cgogn/core/utils/independent_sets.h>
 
 namespace cgogn
 {
@@ -57,23 +58,45 @@ void pliant_remeshing(
 	const Scalar squared_min_edge_length = Scalar(0.5625) * mean_edge_length * mean_edge_length; // 0.5625 = 0.75^2
 	const Scalar squared_max_edge_length = Scalar(1.5625) * mean_edge_length * mean_edge_length; // 1.5625 = 1.25^2
 
-	// cut long edges (and adjacent faces)
+	// cut long edges (all at once) and adjacent faces
+	std::vector<Edge> long_edges;
+	std::vector<Dart> long_edges_opposite;
+	std::vector<VEC3> middles;
 	map.foreach_cell([&] (Edge e)
 	{
 		std::pair<Vertex,Vertex> v = map.vertices(e);
 		const VEC3 edge = position[v.first] - position[v.second];
 		if (edge.squaredNorm() > squared_max_edge_length)
 		{
-			Dart e2 = map.phi2(e.dart);
-			Vertex nv = map.cut_edge(e);
-			position[nv] = Scalar(0.5) * (position[v.first] + position[v.second]);
-			map.cut_face(nv.dart, map.phi_1(e.dart));
-			if (!map.is_boundary(e2))
-				map.cut_face(map.phi1(e2), map.phi_1(e2));
+			long_edges.push_back(e);
+			long_edges_opposite.push_back(map.phi2(e.dart));
+			middles.push_back(Scalar(0.5) * (position[v.first] + position[v.second]));
 		}
 	},
 	cache);
 
+	const std::vector<Vertex> new_vertices = map.cut_edges(long_edges);
+	for (uint32 i = 0u; i < long_edges.size(); ++i)
+		position[new_vertices[i]] = middles[i];
+
+	// the corner of each half of a cut edge is cut off its face
+	// (the darts that follow the new vertices may have been moved to other faces by the previous cuts)
+	// the corners of a face are cut in any order, the edges whose faces do not overlap are processed concurrently
+	IndependentSetScheduler<CMap2> scheduler(map, 0u);
+	scheduler.foreach_independent_set(long_edges, [&] (const std::vector<uint32>& set)
+	{
+		map.begin_concurrent_editing(4u * uint32(set.size()), 4u * uint32(set.size()));
+		parallel_foreach_index(uint32(set.size()), [&] (uint32 k)
+		{
+			const Dart d = long_edges[set[k]].dart;
+			map.cut_face(map.phi1(d), map.phi_1(d));
+			const Dart d2 = long_edges_opposite[set[k]];
+			if (!map.is_boundary(d2))
+				map.cut_face(map.phi1(d2), map.phi_1(d2));
+		});
+		map.end_concurrent_editing();
+	});
+
 	// collapse short edges
 	map.foreach_cell([&] (Edge e)
 	{
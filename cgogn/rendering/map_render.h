@@ -30,6 +30,7 @@
 #include <cgogn/core/cmap/map_base.h> // impossible to include directly attribute.h !
 
 #include <cgogn/geometry/algos/ear_triangulation.h>
+#include <cgogn/geometry/algos/transform.h>
 
 #include <cgogn/rendering/drawer.h>
 #include <cgogn/rendering/shaders/vbo.h>
@@ -349,16 +350,15 @@ public:
  * @param map
  * @param pos_in input position
  * @param pos_out transformed positions
- * @param view modelview matrix
+ * @param view modelview matrix (affine, its last row is ignored)
  */
 template <typename VEC3, typename MAP>
 void transform_position(const MAP& map, const typename MAP::template VertexAttribute<VEC3>& pos_in, typename MAP::template VertexAttribute<VEC3>& pos_out, const QMatrix4x4& view)
 {
-	map.template const_attribute_container<MAP::Vertex::ORBIT>().parallel_foreach_index( [&] (uint32 i)
-	{
-		QVector3D P = view.map(QVector3D(pos_in[i][0],pos_in[i][1],pos_in[i][2]));
-		pos_out[i]= VEC3(P[0],P[1],P[2]);
-	});
+	using Scalar = typename geometry::vector_traits<VEC3>::Scalar;
+	// QMatrix4x4 stores its coefficients in column-major order, as Eigen does
+	const Eigen::Matrix<Scalar, 4, 4> m = Eigen::Map<const Eigen::Matrix4f>(view.constData()).template cast<Scalar>();
+	geometry::transform_position<VEC3>(map, pos_in, pos_out, m);
 }
 
 /**
@@ -236,7 +236,9 @@ void update_vbo(const ATTR& attr, VBO* vbo)
 
 	uint32 byte_chunk_size;
 	std::vector<const void*> chunk_addr = ca->chunks_pointers(byte_chunk_size);
-	const uint32 nb_chunks = uint32(chunk_addr.size());
+	// with a structure of arrays layout, chunks_pointers returns one pointer per component of each chunk
+	const uint32 nb_soa_components = ca->soa_layout() ? ca->nb_components() : 1u;
+	const uint32 nb_chunks = uint32(chunk_addr.size()) / nb_soa_components;
 
 	const uint32 vec_dim = geometry::nb_components_traits<typename ATTR::value_type>::value;
 
@@ -244,6 +246,26 @@ void update_vbo(const ATTR& attr, VBO* vbo)
 
 	const uint32 vbo_blk_bytes = ATTR::CHUNK_SIZE * vec_dim * sizeof(float32);
 
+	// structure of arrays layout : interleave the components (and convert to float)
+	if (ca->soa_layout())
+	{
+		float32* float_buffer = new float32[ATTR::CHUNK_SIZE * vec_dim];
+		vbo->bind();
+		for (uint32 i = 0; i < nb_chunks; ++i)
+		{
+			for (uint32 k = 0; k < vec_dim; ++k)
+			{
+				const Scalar* src = reinterpret_cast<const Scalar*>(chunk_addr[i * nb_soa_components + k]);
+				for (uint32 j = 0; j < ATTR::CHUNK_SIZE; ++j)
+					float_buffer[j * vec_dim + k] = float32(src[j]);
+			}
+			vbo->copy_data(i * vbo_blk_bytes, vbo_blk_bytes, float_buffer);
+		}
+		vbo->release();
+		delete[] float_buffer;
+		return;
+	}
+
 	// handle the case where we want to use SIMD with Eigen::AlignedVector3
 	if (std::is_same<typename ATTR::value_type, Eigen::AlignedVector3<Scalar>>::value)
 	{
@@ -24,6 +24,8 @@
 #ifndef CGOGN_TOPOLOGY_SCALAR_FIELD_H_
 #define CGOGN_TOPOLOGY_SCALAR_FIELD_H_
 
+#include <queue>
+
 #include <cgogn/topology/types/adjacency_cache.h>
 #include <cgogn/topology/types/critical_point.h>
 
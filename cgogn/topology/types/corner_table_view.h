@@ -0,0 +1,304 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_TOPOLOGY_TYPES_CORNER_TABLE_VIEW_H_
+#define CGOGN_TOPOLOGY_TYPES_CORNER_TABLE_VIEW_H_
+
+#include <atomic>
+#include <vector>
+
+#include <cgogn/topology/dll.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+namespace cgogn
+{
+
+namespace topology
+{
+
+/**
+ * @brief read-only corner table of the triangles of a CMap2Tri (or of a CMap2 with triangle faces)
+ * The corners of the face f of the view are 3f, 3f+1 and 3f+2 (in phi1 order). For each corner, the table stores
+ * the vertex (embedding index of the vertex of the corner, the attributes can be accessed with it without
+ * any dart or embedding indirection) and the opposite corner in the adjacent face (INVALID_INDEX on the boundary).
+ * The view is built once and is not updated when the map is modified.
+ */
+template <typename MAP>
+class CornerTableView
+{
+public:
+
+	using Self = CornerTableView<MAP>;
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	inline CornerTableView(const MAP& map) :
+		map_(map)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CornerTableView);
+
+	inline ~CornerTableView()
+	{}
+
+	/**
+	 * @brief build the tables from the faces of the map (in parallel)
+	 * @return false if the vertices of the map are not embedded or if a face is not a triangle (the view is then empty)
+	 */
+	bool build()
+	{
+		clear();
+
+		if (!map_.template is_embedded<Vertex>())
+		{
+			cgogn_log_error("CornerTableView::build") << "The vertices of the map are not embedded.";
+			return false;
+		}
+
+		map_.foreach_cell([&] (Face f) { faces_.push_back(f.dart); });
+
+		const uint32 nb_corners = 3u * nb_faces();
+		corner_vertex_.resize(nb_corners);
+		opposite_corner_.resize(nb_corners);
+		std::vector<uint32> dart_corner(map_.topology_container().end(), INVALID_INDEX);
+
+		// vertices of the corners
+		std::atomic<bool> triangles(true);
+		parallel_foreach_index(nb_faces(), [&] (uint32 f)
+		{
+			Dart d = faces_[f];
+			for (uint32 c = 3u * f; c < 3u * f + 3u; ++c, d = map_.phi1(d))
+			{
+				corner_vertex_[c] = map_.embedding(Vertex(d));
+				dart_corner[d.index] = c;
+			}
+			if (d != faces_[f])
+				triangles = false;
+		});
+		if (!triangles)
+		{
+			cgogn_log_error("CornerTableView::build") << "The faces of the map are not all triangles.";
+			clear();
+			return false;
+		}
+
+		// opposite corners: the edge opposite to c is the edge of the dart of next(c)
+		parallel_foreach_index(nb_faces(), [&] (uint32 f)
+		{
+			Dart d = faces_[f];
+			for (uint32 c = 3u * f; c < 3u * f + 3u; ++c, d = map_.phi1(d))
+			{
+				const uint32 c2 = dart_corner[map_.phi2(d).index];
+				opposite_corner_[prev(c)] = c2 == INVALID_INDEX ? INVALID_INDEX : prev(c2);
+			}
+		});
+
+		// a corner per vertex: the smallest one, a boundary vertex starting with the corner that has no predecessor
+		// around the vertex (@see foreach_adjacent_vertex_through_edge)
+		const uint32 nb_vertices = map_.template attribute_container<Vertex::ORBIT>().end();
+		const uint32 INTERIOR = 0x80000000u;
+		std::vector<std::atomic<uint32>> first_corner(nb_vertices);
+		for (auto& fc : first_corner)
+			fc.store(INVALID_INDEX, std::memory_order_relaxed);
+		parallel_foreach_index(nb_faces(), [&] (uint32 f)
+		{
+			for (uint32 c = 3u * f; c < 3u * f + 3u; ++c)
+			{
+				const uint32 key = opposite_corner_[prev(c)] == INVALID_INDEX ? c : (c | INTERIOR);
+				std::atomic<uint32>& fc = first_corner[corner_vertex_[c]];
+				uint32 current = fc.load(std::memory_order_relaxed);
+				while (key < current && !fc.compare_exchange_weak(current, key, std::memory_order_relaxed))
+				{}
+			}
+		});
+		vertex_corner_.resize(nb_vertices);
+		parallel_foreach_index(nb_vertices, [&] (uint32 v)
+		{
+			const uint32 key = first_corner[v].load(std::memory_order_relaxed);
+			vertex_corner_[v] = key == INVALID_INDEX ? INVALID_INDEX : (key & ~INTERIOR);
+		});
+
+		return true;
+	}
+
+	inline void clear()
+	{
+		faces_.clear();
+		corner_vertex_.clear();
+		opposite_corner_.clear();
+		vertex_corner_.clear();
+	}
+
+	inline uint32 nb_faces() const
+	{
+		return uint32(faces_.size());
+	}
+
+	inline uint32 nb_corners() const
+	{
+		return uint32(corner_vertex_.size());
+	}
+
+	static inline uint32 next(uint32 c)
+	{
+		return c % 3u == 2u ? c - 2u : c + 1u;
+	}
+
+	static inline uint32 prev(uint32 c)
+	{
+		return c % 3u == 0u ? c + 2u : c - 1u;
+	}
+
+	static inline uint32 face_of(uint32 c)
+	{
+		return c / 3u;
+	}
+
+	/**
+	 * @return the embedding index of the vertex of the corner c
+	 */
+	inline uint32 vertex(uint32 c) const
+	{
+		return corner_vertex_[c];
+	}
+
+	/**
+	 * @return the corner opposite to c in the face adjacent through the edge opposite to c (INVALID_INDEX on the boundary)
+	 */
+	inline uint32 opposite(uint32 c) const
+	{
+		return opposite_corner_[c];
+	}
+
+	/**
+	 * @return a corner of the vertex of embedding index v (INVALID_INDEX if v has no incident face)
+	 */
+	inline uint32 corner(uint32 v) const
+	{
+		return vertex_corner_[v];
+	}
+
+	/**
+	 * @return the face of the map that is the face f of the view
+	 */
+	inline Face face(uint32 f) const
+	{
+		return Face(faces_[f]);
+	}
+
+	/**
+	 * @brief apply a function on the embedding index of the vertices that have an incident face
+	 */
+	template <typename FUNC>
+	inline void foreach_vertex(const FUNC& func) const
+	{
+		for (uint32 v = 0u, end = uint32(vertex_corner_.size()); v < end; ++v)
+			if (vertex_corner_[v] != INVALID_INDEX)
+				func(v);
+	}
+
+	template <typename FUNC>
+	inline void parallel_foreach_vertex(const FUNC& func) const
+	{
+		parallel_foreach_index(uint32(vertex_corner_.size()), [&] (uint32 v)
+		{
+			if (vertex_corner_[v] != INVALID_INDEX)
+				func(v);
+		});
+	}
+
+	/**
+	 * @brief apply a function on the faces of the view (indices in [0, nb_faces()))
+	 */
+	template <typename FUNC>
+	inline void foreach_face(const FUNC& func) const
+	{
+		for (uint32 f = 0u, end = nb_faces(); f < end; ++f)
+			func(f);
+	}
+
+	template <typename FUNC>
+	inline void parallel_foreach_face(const FUNC& func) const
+	{
+		parallel_foreach_index(nb_faces(), func);
+	}
+
+	/**
+	 * @brief apply a function on the corners around the vertex of embedding index v
+	 * The corners are visited in the order of the faces around the vertex,
+	 * starting at the boundary for a boundary vertex.
+	 * @return the last visited corner if the vertex is on the boundary, INVALID_INDEX otherwise
+	 */
+	template <typename FUNC>
+	inline uint32 foreach_corner_of_vertex(uint32 v, const FUNC& func) const
+	{
+		const uint32 start = vertex_corner_[v];
+		if (start == INVALID_INDEX)
+			return INVALID_INDEX;
+		uint32 c = start;
+		do
+		{
+			func(c);
+			const uint32 o = opposite_corner_[next(c)];
+			if (o == INVALID_INDEX)
+				return c;
+			c = next(o);
+		} while (c != start);
+		return INVALID_INDEX;
+	}
+
+	template <typename FUNC>
+	inline void foreach_adjacent_vertex_through_edge(uint32 v, const FUNC& func) const
+	{
+		const uint32 last = foreach_corner_of_vertex(v, [&] (uint32 c) { func(corner_vertex_[next(c)]); });
+		if (last != INVALID_INDEX)
+			func(corner_vertex_[prev(last)]);
+	}
+
+	template <typename FUNC>
+	inline void foreach_incident_face(uint32 v, const FUNC& func) const
+	{
+		foreach_corner_of_vertex(v, [&] (uint32 c) { func(face_of(c)); });
+	}
+
+private:
+
+	const MAP& map_;
+	std::vector<Dart> faces_;
+	std::vector<uint32> corner_vertex_;
+	std::vector<uint32> opposite_corner_;
+	std::vector<uint32> vertex_corner_;
+};
+
+#if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_TOPOLOGY_TYPES_CORNER_TABLE_VIEW_CPP_))
+extern template class CGOGN_TOPLOGY_API CornerTableView<CMap2>;
+extern template class CGOGN_TOPLOGY_API CornerTableView<CMap2Tri>;
+#endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_TOPOLOGY_TYPES_CORNER_TABLE_VIEW_CPP_))
+
+} // namespace topology
+
+} // namespace cgogn
+
+#endif // CGOGN_TOPOLOGY_TYPES_CORNER_TABLE_VIEW_H_